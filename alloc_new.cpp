@@ -0,0 +1,225 @@
+/*!
+ * \file   alloc_new.cpp
+ * \brief  Replacement of global operator new/delete for the allocation tracker (libprotest_alloc).
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <cstdlib>
+#include <new>
+#include <protest/alloc_tracker.hpp>
+
+namespace	{
+
+//! スレッドごとの計数。ゼロ初期化されるので、初期化のための確保は起きない。
+struct	Counters {
+	bool			active;
+	size_t			allocations;
+	size_t			deallocations;
+	size_t			bytes;
+	//! 計測開始後に確保されたままのバイト数。開始前の領域を解放すると負になりうる。
+	long long		current;
+	size_t			peak;
+};
+thread_local Counters	counters;
+
+//! 解放時に大きさがわかるよう、各領域の前に大きさを書いておく。アライメントを保つため max_align_t 分確保する。
+constexpr size_t	headerSize = alignof(std::max_align_t);
+
+//! Offset of the returned pointer from the start of the block.
+/*!
+ * 大きさは常に返すポインタの headerSize バイト前に書く。
+ * 過剰アライメントの場合は、返すポインタがアライメントに揃うよう align バイト前に置く。
+ */
+constexpr size_t	offsetFor(size_t align)
+{
+	return	(align > headerSize) ? align : headerSize;
+}
+
+void			*allocateBlock(size_t size, size_t align)
+{
+	if(align <= headerSize) {
+		return	std::malloc(size);
+	}
+	void			*p = nullptr;
+	return	(::posix_memalign(&p, align, size) == 0) ? p : nullptr;
+}
+
+void			*allocate(size_t size, size_t align=headerSize)
+{
+	const size_t	offset = offsetFor(align);
+	for(;;) {
+		if(void *p = allocateBlock(size + offset, align)) {
+			char			*ret = static_cast<char *>(p) + offset;
+			*reinterpret_cast<size_t *>(ret - headerSize) = size;
+			auto			&c = counters;
+			if(c.active) {
+				++c.allocations;
+				c.bytes += size;
+				c.current += static_cast<long long>(size);
+				if((c.current > 0) && (static_cast<size_t>(c.current) > c.peak)) {
+					c.peak = static_cast<size_t>(c.current);
+				}
+			}
+			return	ret;
+		}
+		std::new_handler	handler = std::get_new_handler();
+		if(!handler) {
+			throw	std::bad_alloc();
+		}
+		handler();
+	}
+}
+
+void			*allocateNothrow(size_t size, size_t align=headerSize) noexcept
+{
+	try {
+		return	allocate(size, align);
+	} catch(...) {
+		return	nullptr;
+	}
+}
+
+void			deallocate(void *ptr, size_t align=headerSize) noexcept
+{
+	if(!ptr) {
+		return;
+	}
+	char			*p = static_cast<char *>(ptr);
+	auto			&c = counters;
+	if(c.active) {
+		++c.deallocations;
+		c.current -= static_cast<long long>(*reinterpret_cast<size_t *>(p - headerSize));
+	}
+	std::free(p - offsetFor(align));
+}
+
+void			beginTracking(void)
+{
+	counters = Counters();
+	counters.active = true;
+}
+
+nu11p0::protest::AllocStats	endTracking(void)
+{
+	counters.active = false;
+	nu11p0::protest::AllocStats	stats;
+	stats.allocations = counters.allocations;
+	stats.deallocations = counters.deallocations;
+	stats.bytes = counters.bytes;
+	stats.peakBytes = counters.peak;
+	return	stats;
+}
+
+const nu11p0::protest::detail::AllocTrackerHooks	hooks = {&beginTracking, &endTracking};
+
+struct	Registrar {
+	Registrar() {
+		nu11p0::protest::detail::registerAllocTracker(&hooks);
+	}
+} registrar;
+
+} // anonymous namespace
+
+void			*operator new(size_t size)
+{
+	return	allocate(size);
+}
+
+void			*operator new[](size_t size)
+{
+	return	allocate(size);
+}
+
+void			*operator new(size_t size, const std::nothrow_t &) noexcept
+{
+	return	allocateNothrow(size);
+}
+
+void			*operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+	return	allocateNothrow(size);
+}
+
+void			operator delete(void *ptr) noexcept
+{
+	deallocate(ptr);
+}
+
+void			operator delete[](void *ptr) noexcept
+{
+	deallocate(ptr);
+}
+
+void			operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+	deallocate(ptr);
+}
+
+void			operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+	deallocate(ptr);
+}
+
+void			operator delete(void *ptr, size_t) noexcept
+{
+	deallocate(ptr);
+}
+
+void			operator delete[](void *ptr, size_t) noexcept
+{
+	deallocate(ptr);
+}
+
+#if defined(__cpp_aligned_new) && __cpp_aligned_new
+// 過剰アライメントの型(alignas で __STDCPP_DEFAULT_NEW_ALIGNMENT__ を超えるもの)の new/delete 。
+void			*operator new(size_t size, std::align_val_t align)
+{
+	return	allocate(size, static_cast<size_t>(align));
+}
+
+void			*operator new[](size_t size, std::align_val_t align)
+{
+	return	allocate(size, static_cast<size_t>(align));
+}
+
+void			*operator new(size_t size, std::align_val_t align, const std::nothrow_t &) noexcept
+{
+	return	allocateNothrow(size, static_cast<size_t>(align));
+}
+
+void			*operator new[](size_t size, std::align_val_t align, const std::nothrow_t &) noexcept
+{
+	return	allocateNothrow(size, static_cast<size_t>(align));
+}
+
+void			operator delete(void *ptr, std::align_val_t align) noexcept
+{
+	deallocate(ptr, static_cast<size_t>(align));
+}
+
+void			operator delete[](void *ptr, std::align_val_t align) noexcept
+{
+	deallocate(ptr, static_cast<size_t>(align));
+}
+
+void			operator delete(void *ptr, std::align_val_t align, const std::nothrow_t &) noexcept
+{
+	deallocate(ptr, static_cast<size_t>(align));
+}
+
+void			operator delete[](void *ptr, std::align_val_t align, const std::nothrow_t &) noexcept
+{
+	deallocate(ptr, static_cast<size_t>(align));
+}
+
+void			operator delete(void *ptr, size_t, std::align_val_t align) noexcept
+{
+	deallocate(ptr, static_cast<size_t>(align));
+}
+
+void			operator delete[](void *ptr, size_t, std::align_val_t align) noexcept
+{
+	deallocate(ptr, static_cast<size_t>(align));
+}
+#endif	// if defined(__cpp_aligned_new) && __cpp_aligned_new
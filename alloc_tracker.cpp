@@ -0,0 +1,51 @@
+/*!
+ * \file   alloc_tracker.cpp
+ * \brief  Heap allocation tracking and allocation-free conditions.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <protest/alloc_tracker.hpp>
+
+namespace	nu11p0 {
+namespace	protest {
+
+namespace	{
+
+// libprotest_alloc がリンクされていれば、その静的初期化で設定される。
+const detail::AllocTrackerHooks	*allocHooks = nullptr;
+
+} // anonymous namespace
+
+namespace	detail {
+
+void			registerAllocTracker(const AllocTrackerHooks *hooks)
+{
+	allocHooks = hooks;
+}
+
+} // namespace detail
+
+namespace	alloc_tracker {
+
+bool			available(void)
+{
+	return	allocHooks != nullptr;
+}
+
+void			begin(void)
+{
+	if(allocHooks) {
+		allocHooks->begin();
+	}
+}
+
+AllocStats		end(void)
+{
+	return	allocHooks ? allocHooks->end() : AllocStats();
+}
+
+} // namespace alloc_tracker
+
+} // namespace protest
+} // namespace nu11p0
@@ -0,0 +1,65 @@
+/*!
+ * \file   arena.cpp
+ * \brief  Monotonic memory arena for test cases.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <algorithm>
+#include <protest/arena.hpp>
+
+namespace	nu11p0 {
+namespace	protest {
+
+Arena::~Arena()
+{
+	while(m_head) {
+		Block			*next = m_head->next;
+		::operator delete(m_head);
+		m_head = next;
+	}
+}
+
+size_t			Arena::capacity(void) const noexcept
+{
+	size_t			total = 0;
+	for(const Block *b = m_head; b; b = b->next) {
+		total += b->size;
+	}
+	return	total;
+}
+
+void			*Arena::allocateSlow(size_t size, size_t align)
+{
+	// reset() 後であれば、後続のブロックに収まるか試す。
+	while(m_current && m_current->next) {
+		m_current = m_current->next;
+		m_cur = m_current->data();
+		m_end = m_cur + m_current->size;
+		auto			p = reinterpret_cast<uintptr_t>(m_cur);
+		auto			aligned = (p + align - 1) & ~static_cast<uintptr_t>(align - 1);
+		if(aligned + size <= reinterpret_cast<uintptr_t>(m_end)) {
+			m_cur = reinterpret_cast<char *>(aligned + size);
+			return	reinterpret_cast<void *>(aligned);
+		}
+	}
+	// 新しいブロックを、直前のブロックの倍の大きさで確保する。
+	size_t			blockSize = std::max(
+			m_current ? m_current->size * 2 : m_initialBlockSize,
+			size + align);
+	auto			block = static_cast<Block *>(::operator new(sizeof(Block) + blockSize));
+	block->next = nullptr;
+	block->size = blockSize;
+	if(m_current) {
+		m_current->next = block;
+	} else {
+		m_head = block;
+	}
+	m_current = block;
+	m_cur = block->data();
+	m_end = m_cur + blockSize;
+	return	allocate(size, align);
+}
+
+} // namespace protest
+} // namespace nu11p0
@@ -0,0 +1,105 @@
+/*!
+ * \file   case_gen.cpp
+ * \brief  Sets of generated cases for case_gen::Unique.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <algorithm>
+#include <protest/case_gen.hpp>
+
+namespace	nu11p0 {
+namespace	protest {
+namespace	case_gen {
+namespace	detail {
+
+namespace	{
+
+//! splitmix64 の最終段。 std::hash の恒等写像のような弱いハッシュを混ぜる。
+uint64_t		mix(uint64_t x)
+{
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9u;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebu;
+	x ^= x >> 31;
+	return	x;
+}
+
+constexpr size_t	bloomBitsPerElement = 10;
+constexpr size_t	bloomHashes = 7;
+//! 層を追加するたびに増やす、1要素あたりのビット数。
+constexpr size_t	bloomBitsGrowth = 5;
+
+} // anonymous namespace
+
+SeenBitmap::SeenBitmap(size_t domain)
+:m_bits((domain + 63) / 64)
+{}
+
+bool			SeenBitmap::insert(size_t key)
+{
+	auto			&word = m_bits[key / 64];
+	const uint64_t	bit = static_cast<uint64_t>(1) << (key % 64);
+	if(word & bit) {
+		return	false;
+	}
+	word |= bit;
+	return	true;
+}
+
+BloomFilter::BloomFilter(size_t capacity)
+:m_layers()
+{
+	addLayer(std::max<size_t>(capacity, 1), bloomBitsPerElement);
+}
+
+void			BloomFilter::addLayer(size_t capacity, size_t bitsPerElement)
+{
+	// ビット数は2の冪に切り上げ、剰余の代わりにマスクを使う。
+	size_t			bits = 64;
+	while(bits < capacity * bitsPerElement) {
+		bits *= 2;
+	}
+	m_layers.push_back(Layer{std::vector<uint64_t>(bits / 64), bits - 1, capacity, 0});
+}
+
+bool			BloomFilter::insert(uint64_t hash)
+{
+	// 二つのハッシュの線形結合で k 個のハッシュを作る(Kirsch-Mitzenmacher)。
+	const uint64_t	h1 = mix(hash);
+	const uint64_t	h2 = mix(h1) | 1;
+	// 満杯になった層は検索にだけ使う。
+	for(size_t n = 0; n + 1 < m_layers.size(); ++n) {
+		const auto		&layer = m_layers[n];
+		bool			found = true;
+		for(size_t i = 0; found && (i < bloomHashes); ++i) {
+			const uint64_t	pos = (h1 + i * h2) & layer.mask;
+			found = (layer.bits[pos / 64] >> (pos % 64)) & 1;
+		}
+		if(found) {
+			return	false;
+		}
+	}
+	auto			&current = m_layers.back();
+	bool			inserted = false;
+	for(size_t i = 0; i < bloomHashes; ++i) {
+		const uint64_t	pos = (h1 + i * h2) & current.mask;
+		auto			&word = current.bits[pos / 64];
+		const uint64_t	bit = static_cast<uint64_t>(1) << (pos % 64);
+		if(!(word & bit)) {
+			word |= bit;
+			inserted = true;
+		}
+	}
+	if(inserted && (++current.count >= current.capacity)) {
+		// 1要素あたりのビット数を増やして、層ごとの偽陽性率を等比的に下げる。
+		addLayer(current.capacity * 2, bloomBitsPerElement + bloomBitsGrowth * m_layers.size());
+	}
+	return	inserted;
+}
+
+} // namespace detail
+} // namespace case_gen
+} // namespace protest
+} // namespace nu11p0
@@ -0,0 +1,88 @@
+/*!
+ * \file   checkpoint.cpp
+ * \brief  Checkpoint files for resuming long test runs.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <cstdio>
+#include <fstream>
+#include <protest/checkpoint.hpp>
+
+namespace	nu11p0 {
+namespace	protest {
+
+namespace	{
+
+const char		checkpointHeader[] = "protest-checkpoint 1";
+
+// 文字列は長さを前置して書くので、改行や空白を含んでいてもよい。
+void			writeString(std::ostream &ost, const std::string &str)
+{
+	ost << str.size() << ' ' << str << '\n';
+}
+
+bool			readString(std::istream &ist, std::string &str)
+{
+	size_t			size;
+	if(!(ist >> size) || (ist.get() != ' ')) {
+		return	false;
+	}
+	str.resize(size);
+	if(size && !ist.read(&str[0], static_cast<std::streamsize>(size))) {
+		return	false;
+	}
+	return	ist.get() == '\n';
+}
+
+} // anonymous namespace
+
+namespace	detail {
+
+bool			writeCheckpoint(const std::string &path, const Checkpoint &cp)
+{
+	const std::string	tmp = path + ".tmp";
+	{
+		std::ofstream	ofs(tmp, std::ios::out | std::ios::trunc | std::ios::binary);
+		if(!ofs) {
+			return	false;
+		}
+		ofs << checkpointHeader << '\n';
+		writeString(ofs, cp.abstract);
+		writeString(ofs, cp.caseDescription);
+		ofs << cp.count << ' ' << cp.passCount << ' ' << cp.skipCount << ' ' << static_cast<long long>(cp.elapsed.count())
+			<< ' ' << (cp.hasGeneratorState ? 1 : 0) << '\n';
+		writeString(ofs, cp.generatorState);
+		if(!ofs.flush()) {
+			return	false;
+		}
+	}
+	return	std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+bool			readCheckpoint(const std::string &path, Checkpoint &cp)
+{
+	std::ifstream	ifs(path, std::ios::in | std::ios::binary);
+	std::string		header;
+	if(!ifs || !std::getline(ifs, header) || (header != checkpointHeader)) {
+		return	false;
+	}
+	long long		elapsed;
+	if(!readString(ifs, cp.abstract) || !readString(ifs, cp.caseDescription)
+			|| !(ifs >> cp.count >> cp.passCount >> cp.skipCount >> elapsed >> cp.hasGeneratorState) || (ifs.get() != '\n')
+			|| !readString(ifs, cp.generatorState)) {
+		return	false;
+	}
+	cp.elapsed = std::chrono::nanoseconds(elapsed);
+	return	true;
+}
+
+void			removeCheckpoint(const std::string &path)
+{
+	std::remove(path.c_str());
+}
+
+} // namespace detail
+
+} // namespace protest
+} // namespace nu11p0
@@ -0,0 +1,131 @@
+/*!
+ * \file   complexity.cpp
+ * \brief  Empirical check of computational complexity.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <protest/complexity.hpp>
+
+namespace	nu11p0 {
+namespace	protest {
+
+namespace	{
+
+const Complexity	classes[] = {
+	Complexity::Constant,
+	Complexity::Logarithmic,
+	Complexity::Linear,
+	Complexity::NLogN,
+	Complexity::Quadratic,
+	Complexity::Cubic,
+};
+
+//! 計測のノイズとみなす相対誤差の rms 。
+constexpr double	noiseFloor = 0.02;
+
+double			evaluate(Complexity c, double n)
+{
+	switch(c) {
+		case Complexity::Constant:
+			return	1.0;
+		case Complexity::Logarithmic:
+			return	std::log2(n);
+		case Complexity::Linear:
+			return	n;
+		case Complexity::NLogN:
+			return	n * std::log2(n);
+		case Complexity::Quadratic:
+			return	n * n;
+		case Complexity::Cubic:
+			return	n * n * n;
+	}
+	return	1.0;
+}
+
+} // anonymous namespace
+
+const char		*complexityName(Complexity c)
+{
+	switch(c) {
+		case Complexity::Constant:
+			return	"O(1)";
+		case Complexity::Logarithmic:
+			return	"O(log n)";
+		case Complexity::Linear:
+			return	"O(n)";
+		case Complexity::NLogN:
+			return	"O(n log n)";
+		case Complexity::Quadratic:
+			return	"O(n^2)";
+		case Complexity::Cubic:
+			return	"O(n^3)";
+	}
+	return	"O(?)";
+}
+
+ComplexityFit	fitComplexity(const std::vector<SizeTiming> &series, double tolerance)
+{
+	ComplexityFit	best;
+	if(series.empty()) {
+		return	best;
+	}
+	// 計測の誤差は時間にほぼ比例するので、重み 1/t^2 の最小二乗で相対誤差を揃える。
+	// こうしないと最大の入力だけで当てはまりが決まり、 O(n) と O(n log n) を見分けにくい。
+	std::vector<double>	times, weights;
+	for(const auto &s : series) {
+		const double	t = std::max(static_cast<double>(s.elapsed.count()), 1.0);
+		times.push_back(t);
+		weights.push_back(1.0 / (t * t));
+	}
+	ComplexityFit	fits[sizeof(classes) / sizeof(classes[0])];
+	double			minRms = std::numeric_limits<double>::infinity();
+	for(size_t i = 0; i < sizeof(classes) / sizeof(classes[0]); ++i) {
+		const auto		c = classes[i];
+		// 切片つきの重みつき最小二乗: Σw(t - a - b*g)^2 を最小にする a, b 。
+		double			sw = 0.0, sg = 0.0, st = 0.0, sgg = 0.0, sgt = 0.0;
+		for(size_t k = 0; k < series.size(); ++k) {
+			const double	g = evaluate(c, static_cast<double>(series[k].size));
+			const double	w = weights[k];
+			sw += w;
+			sg += w * g;
+			st += w * times[k];
+			sgg += w * g * g;
+			sgt += w * g * times[k];
+		}
+		// O(1) では g が一定なので det = 0 になり、時間の(重みつき)平均だけが残る。
+		const double	det = sw * sgg - sg * sg;
+		double			coef = (det > 0.0) ? ((sw * sgt - sg * st) / det) : 0.0;
+		if(coef < 0.0) {
+			coef = 0.0;
+		}
+		const double	intercept = (st - coef * sg) / sw;
+		double			sq = 0.0;
+		for(size_t k = 0; k < series.size(); ++k) {
+			const double	diff = (times[k] - intercept - coef * evaluate(c, static_cast<double>(series[k].size))) / times[k];
+			sq += diff * diff;
+		}
+		fits[i].bestFit = c;
+		fits[i].rms = std::sqrt(sq / static_cast<double>(series.size()));
+		fits[i].coefficient = coef;
+		fits[i].intercept = intercept;
+		if(fits[i].rms < minRms) {
+			minRms = fits[i].rms;
+		}
+	}
+	// キャッシュ等の影響で、 O(n) が O(n log n) にわずかに負けることがある。
+	// 最良との比が 1 + tolerance 以下(とノイズ分)のクラスのうち、最も低いものを選ぶ。
+	const double	limit = minRms * (1.0 + tolerance) + noiseFloor;
+	for(const auto &fit : fits) {
+		if(fit.rms <= limit) {
+			return	fit;
+		}
+	}
+	return	best;
+}
+
+} // namespace protest
+} // namespace nu11p0
@@ -0,0 +1,122 @@
+/*!
+ * \file   coroutine_test.cpp
+ * \brief  Test of CheckTask, which is defined only with C++20 coroutines.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++20
+ */
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <protest/async_test.hpp>
+#include <protest/condition.hpp>
+
+namespace	protest = nu11p0::protest;
+
+#ifndef	PROTEST_HAVE_COROUTINE_
+#	error	"coroutine_test.cpp must be compiled with C++20 coroutines"
+#endif
+
+//! Awaitable which resumes the coroutine on another thread, like a completion of I/O.
+class	Resumer {
+	private:
+		std::mutex		m_mutex;
+		std::vector<std::thread>	m_threads;
+	public:
+		Resumer()
+		:m_mutex()
+		,m_threads()
+		{}
+		~Resumer()
+		{
+			for(auto &t : m_threads) {
+				t.join();
+			}
+		}
+		struct	Awaiter {
+			Resumer			&resumer;
+			std::chrono::microseconds	delay;
+			bool			await_ready(void) const noexcept
+			{
+				return	false;
+			}
+			void			await_suspend(std::coroutine_handle<> handle) const
+			{
+				const auto		d = delay;
+				std::lock_guard<std::mutex>	lock(resumer.m_mutex);
+				resumer.m_threads.emplace_back([handle, d]() {
+						std::this_thread::sleep_for(d);
+						handle.resume();
+					});
+			}
+			void			await_resume(void) const noexcept
+			{}
+		};
+		Awaiter			after(std::chrono::microseconds delay)
+		{
+			return	Awaiter{*this, delay};
+		}
+}; // class Resumer
+
+int				checkTaskTest(void)
+{
+	Resumer			resumer;
+	protest::AsyncTest<int>	test(
+			"CheckTask test for AsyncTest",
+			[&resumer](const int &arg) -> protest::CheckTask {
+				// 後に生成されたケースほど早く終わるようにする。
+				co_await resumer.after(std::chrono::microseconds(100 * (8 - arg % 8)));
+				co_return protest::AssertResult((arg != 37) && (arg != 38), "failure");
+			}
+		);
+	test.maxInFlight(8);
+	int				next = 0;
+	auto			result = test.runTest(
+			"counting case",
+			[&next]() { return	protest::ns_optional::optional<int>(next++); },
+			100,
+			std::cout);
+	if((protest::case_cast<int>(result.failedCase) != 37) || (result.passCount != 37)) {
+		std::cout << "error: CheckTask did not report the first failure" << std::endl;
+		return	1;
+	}
+	return	0;
+}
+
+int				checkTaskExceptionTest(void)
+{
+	protest::AsyncTest<int>	test(
+			"CheckTask exception test",
+			[](const int &arg) -> protest::CheckTask {
+				if(arg == 3) {
+					throw	std::runtime_error("thrown from a coroutine");
+				}
+				co_return protest::AssertResult(true, "");
+			}
+		);
+	int				next = 0;
+	try {
+		test.runTest("counting case", [&next]() { return	protest::ns_optional::optional<int>(next++); }, 10);
+	} catch(const std::runtime_error &) {
+		return	0;
+	}
+	std::cout << "error: exception in CheckTask is not propagated" << std::endl;
+	return	1;
+}
+
+int				main(void)
+{
+	int				ret = 0;
+	if(( ret = checkTaskTest() )) {
+		return	ret;
+	}
+	if(( ret = checkTaskExceptionTest() )) {
+		return	ret;
+	}
+	return	0;
+}
@@ -0,0 +1,165 @@
+/*!
+ * \file   coverage.cpp
+ * \brief  Callbacks for -fsanitize-coverage=trace-pc-guard and corpus storage.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <protest/fuzz.hpp>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+namespace	{
+
+/*
+ * 計装されたモジュールのコンストラクタは、このファイルの静的オブジェクトの初期化より先に
+ * 実行されうるため、状態は全てゼロ初期化されるPODで持つ。
+ */
+// guard番号(1始まり)ごとのヒット数。
+uint8_t			*g_counters = nullptr;
+// guard番号ごとの、既に観測したヒット数バケットのビット集合。
+uint8_t			*g_seen = nullptr;
+size_t			g_guardCount = 0;
+size_t			g_featureCount = 0;
+
+// AFLと同様に、ヒット数を8段階のバケットに分類する。
+inline uint8_t	bucketBit(uint8_t hits)
+{
+	return
+		(hits >= 128) ? 0x80 :
+		(hits >= 32) ? 0x40 :
+		(hits >= 16) ? 0x20 :
+		(hits >= 8) ? 0x10 :
+		(hits >= 4) ? 0x08 :
+		(hits == 3) ? 0x04 :
+		(hits == 2) ? 0x02 :
+		0x01;
+}
+
+} // anonymous namespace
+
+extern "C" {
+
+void			__sanitizer_cov_trace_pc_guard_init(uint32_t *start, uint32_t *stop)
+{
+	if((start == stop) || *start) {
+		// 初期化済み。
+		return;
+	}
+	size_t			newCount = g_guardCount + static_cast<size_t>(stop - start);
+	// 番号0は無効なguardを表すので、1つ余分に確保する。
+	auto			counters = static_cast<uint8_t *>(std::realloc(g_counters, newCount + 1));
+	auto			seen = static_cast<uint8_t *>(std::realloc(g_seen, newCount + 1));
+	if(!counters || !seen) {
+		// 確保できなければ計装を無効のままにする。
+		g_counters = counters ? counters : g_counters;
+		g_seen = seen ? seen : g_seen;
+		return;
+	}
+	std::memset(counters + g_guardCount + 1, 0, newCount - g_guardCount);
+	std::memset(seen + g_guardCount + 1, 0, newCount - g_guardCount);
+	g_counters = counters;
+	g_seen = seen;
+	for(uint32_t *guard = start; guard != stop; ++guard) {
+		*guard = static_cast<uint32_t>(++g_guardCount);
+	}
+}
+
+void			__sanitizer_cov_trace_pc_guard(uint32_t *guard)
+{
+	// 無効化されたguardは0になっている。
+	if(*guard) {
+		++g_counters[*guard];
+	}
+}
+
+} // extern "C"
+
+namespace	nu11p0 {
+namespace	protest {
+namespace	coverage {
+
+size_t			guardCount(void)
+{
+	return	g_guardCount;
+}
+
+size_t			featureCount(void)
+{
+	return	g_featureCount;
+}
+
+void			clearCounters(void)
+{
+	if(g_guardCount) {
+		std::memset(g_counters + 1, 0, g_guardCount);
+	}
+}
+
+size_t			mergeCounters(void)
+{
+	size_t			newFeatures = 0;
+	for(size_t i = 1; i <= g_guardCount; ++i) {
+		if(uint8_t hits = g_counters[i]) {
+			g_counters[i] = 0;
+			uint8_t			bit = bucketBit(hits);
+			if(!(g_seen[i] & bit)) {
+				g_seen[i] |= bit;
+				++newFeatures;
+			}
+		}
+	}
+	g_featureCount += newFeatures;
+	return	newFeatures;
+}
+
+std::vector<std::string>	loadCorpus(const std::string &dir)
+{
+	std::vector<std::string>	corpus;
+	DIR				*d = opendir(dir.c_str());
+	if(!d) {
+		return	corpus;
+	}
+	while(dirent *ent = readdir(d)) {
+		if(ent->d_name[0] == '.') {
+			continue;
+		}
+		std::string		path = dir + '/' + ent->d_name;
+		struct stat		st;
+		if((stat(path.c_str(), &st) != 0) || !S_ISREG(st.st_mode)) {
+			continue;
+		}
+		std::ifstream	ifs(path, std::ios::binary);
+		corpus.emplace_back(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+	}
+	closedir(d);
+	return	corpus;
+}
+
+bool			storeCorpusEntry(const std::string &dir, const std::string &data)
+{
+	// FNV-1a (64bit)
+	uint64_t		hash = 14695981039346656037ull;
+	for(unsigned char c : data) {
+		hash = (hash ^ c) * 1099511628211ull;
+	}
+	static const char	hex[] = "0123456789abcdef";
+	std::string		name(16, '0');
+	for(size_t i = 0; i < 16; ++i) {
+		name[15-i] = hex[(hash >> (i*4)) & 0xf];
+	}
+	mkdir(dir.c_str(), 0777);
+	std::ofstream	ofs(dir + '/' + name, std::ios::binary | std::ios::trunc);
+	ofs.write(data.data(), static_cast<std::streamsize>(data.size()));
+	return	static_cast<bool>(ofs);
+}
+
+} // namespace coverage
+} // namespace protest
+} // namespace nu11p0
@@ -0,0 +1,56 @@
+/*!
+ * \file   generic_test.cpp
+ * \brief  Test for generic functions.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <cmath>
+#include <protest/generic_test.hpp>
+
+namespace	nu11p0 {
+namespace	protest {
+namespace	generic {
+namespace	detail {
+
+std::vector<size_t>	allocateBudget(const std::vector<double> &weights, const std::vector<double> &costs, const std::vector<size_t> &caps, double budget)
+{
+	const size_t	n = weights.size();
+	std::vector<size_t>	counts(n);
+	std::vector<bool>	open(n);
+	double			totalWeight = 0.0;
+	for(size_t i = 0; i < n; ++i) {
+		open[i] = (caps[i] > 0) && (weights[i] > 0.0);
+		if(open[i]) {
+			totalWeight += weights[i];
+		}
+	}
+	// 上限に達した型を除いて配り直す。上限に達する型が無くなれば終わり。
+	for(bool capped = true; capped && (totalWeight > 0.0) && (budget > 0.0); ) {
+		capped = false;
+		for(size_t i = 0; i < n; ++i) {
+			if(!open[i]) {
+				continue;
+			}
+			const double	share = budget * weights[i] / totalWeight;
+			if(share / costs[i] >= static_cast<double>(caps[i])) {
+				counts[i] = caps[i];
+				open[i] = false;
+				budget -= static_cast<double>(caps[i]) * costs[i];
+				totalWeight -= weights[i];
+				capped = true;
+			}
+		}
+	}
+	for(size_t i = 0; i < n; ++i) {
+		if(open[i] && (totalWeight > 0.0) && (budget > 0.0)) {
+			counts[i] = static_cast<size_t>(std::floor(budget * weights[i] / totalWeight / costs[i]));
+		}
+	}
+	return	counts;
+}
+
+} // namespace detail
+} // namespace generic
+} // namespace protest
+} // namespace nu11p0
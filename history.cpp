@@ -0,0 +1,131 @@
+/*!
+ * \file   history.cpp
+ * \brief  Outcomes of previous runs, for fail-fast test ordering.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <protest/history.hpp>
+#include <protest/runner.hpp>
+
+namespace	nu11p0 {
+namespace	protest {
+
+namespace	{
+
+const char		historyHeader[] = "# protest history 1";
+//! 名前の後に続く数値の列の数。
+constexpr size_t	historyFields = 5;
+
+} // anonymous namespace
+
+TestHistory::TestHistory()
+:m_entries()
+{}
+
+bool			TestHistory::load(const std::string &path)
+{
+	m_entries.clear();
+	std::ifstream	ifs(path);
+	if(!ifs) {
+		return	true;
+	}
+	std::string		line;
+	while(std::getline(ifs, line)) {
+		if(line.empty() || (line[0] == '#')) {
+			continue;
+		}
+		// 名前にタブが含まれていてもよいよう、数値の列は後ろから数える。
+		size_t			pos = line.size();
+		for(size_t i = 0; (i < historyFields) && (pos != std::string::npos); ++i) {
+			pos = (pos == 0) ? std::string::npos : line.rfind('\t', pos - 1);
+		}
+		if(pos == std::string::npos) {
+			return	false;
+		}
+		HistoryEntry	entry;
+		long long		durationNs = 0;
+		std::istringstream	iss(line.substr(pos + 1));
+		if(!(iss >> entry.lastFailed >> entry.runs >> entry.failureScore >> durationNs >> entry.cases)) {
+			return	false;
+		}
+		entry.duration = std::chrono::nanoseconds(durationNs);
+		m_entries[line.substr(0, pos)] = entry;
+	}
+	return	true;
+}
+
+bool			TestHistory::save(const std::string &path) const
+{
+	const std::string	tmp = path + ".tmp";
+	{
+		std::ofstream	ofs(tmp, std::ios::out | std::ios::trunc);
+		if(!ofs) {
+			return	false;
+		}
+		ofs << historyHeader << '\n';
+		for(const auto &e : m_entries) {
+			const auto		&entry = e.second;
+			ofs << e.first
+				<< '\t' << (entry.lastFailed ? 1 : 0)
+				<< '\t' << entry.runs
+				<< '\t' << entry.failureScore
+				<< '\t' << static_cast<long long>(entry.duration.count())
+				<< '\t' << entry.cases
+				<< '\n';
+		}
+		if(!ofs.flush()) {
+			return	false;
+		}
+	}
+	return	std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+const HistoryEntry	*TestHistory::find(const std::string &name) const
+{
+	const auto		it = m_entries.find(name);
+	return	(it != m_entries.end()) ? &it->second : nullptr;
+}
+
+void			TestHistory::update(const std::string &name, bool failed, std::chrono::nanoseconds duration, size_t cases)
+{
+	auto			&entry = m_entries[name];
+	entry.lastFailed = failed;
+	++entry.runs;
+	entry.failureScore = entry.failureScore * 0.5 + (failed ? 1.0 : 0.0);
+	entry.duration = duration;
+	entry.cases = cases;
+}
+
+std::vector<size_t>	TestHistory::schedule(const std::vector<const TestInfo *> &tests) const
+{
+	const HistoryEntry	unknown;
+	std::vector<const HistoryEntry *>	entries;
+	for(const auto *test : tests) {
+		const auto		*entry = find(test->name);
+		entries.push_back(entry ? entry : &unknown);
+	}
+	std::vector<size_t>	ret(tests.size());
+	for(size_t i = 0; i < ret.size(); ++i) {
+		ret[i] = i;
+	}
+	std::stable_sort(ret.begin(), ret.end(), [&entries](size_t a, size_t b) {
+			const auto		&ea = *entries[a];
+			const auto		&eb = *entries[b];
+			if(ea.failureScore > eb.failureScore) {
+				return	true;
+			}
+			if(ea.failureScore < eb.failureScore) {
+				return	false;
+			}
+			return	ea.duration < eb.duration;
+		});
+	return	ret;
+}
+
+} // namespace protest
+} // namespace nu11p0
@@ -0,0 +1,125 @@
+/*!
+ * \file   alloc_tracker.hpp
+ * \brief  Heap allocation tracking and allocation-free conditions.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__ALLOC_TRACKER_HPP_
+#define	INCLUDED__NU11P0__PROTEST__ALLOC_TRACKER_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+#ifndef	INCLUDED__NU11P0__PROTEST__PERF_CONDITION_HPP_
+#	include <protest/perf_condition.hpp>
+#endif
+
+#include <functional>
+#include <string>
+
+namespace	nu11p0 {
+namespace	protest {
+
+//! Heap allocations counted by the tracker.
+struct	AllocStats {
+	//! operator new の呼び出し回数。
+	size_t			allocations;
+	//! operator delete の呼び出し回数。
+	size_t			deallocations;
+	//! 確保したバイト数の合計。
+	size_t			bytes;
+	//! 計測中に確保されたままだったバイト数の最大値。
+	size_t			peakBytes;
+	AllocStats()
+	:allocations()
+	,deallocations()
+	,bytes()
+	,peakBytes()
+	{}
+}; // struct AllocStats
+
+//! Allocation tracker.
+/*!
+ * 計測には libprotest_alloc のリンクが必要。
+ * libprotest_alloc はグローバルな operator new/delete を置き換え、呼び出したスレッドでの確保を数える。
+ * リンクされていない場合、 available() は false を返し、計測結果は常に0になる。
+ */
+namespace	alloc_tracker {
+	//! True if libprotest_alloc is linked.
+	bool			available(void);
+	//! Start counting allocations on the current thread.
+	void			begin(void);
+	//! Stop counting and return the counts since begin().
+	AllocStats		end(void);
+} // namespace alloc_tracker
+
+namespace	detail {
+	//! Functions provided by libprotest_alloc.
+	struct	AllocTrackerHooks {
+		void			(*begin)(void);
+		AllocStats		(*end)(void);
+	};
+	//! Called by libprotest_alloc at static initialization.
+	void			registerAllocTracker(const AllocTrackerHooks *hooks);
+} // namespace detail
+
+//! Check that the function allocates at most the given number of times (and bytes) for each case.
+/*!
+ * 関数の戻り値の構築と破棄も計測に含まれる。
+ * libprotest_alloc がリンクされていない場合は、計測できないので失敗する。
+ */
+template <typename Param>
+class	AllocatesAtMost {
+	public:
+		using	param_type = Param;
+	private:
+		std::function<void(const param_type &)>	m_fun;
+		size_t			m_maxAllocations;
+		size_t			m_maxBytes;
+	public:
+		template <typename F>
+		AllocatesAtMost(F &&f, size_t maxAllocations, size_t maxBytes=SIZE_MAX)
+		:m_fun(detail::measurable<param_type>(std::forward<F>(f)))
+		,m_maxAllocations(maxAllocations)
+		,m_maxBytes(maxBytes)
+		{}
+		CheckResult		operator()(const param_type &arg)
+		{
+			CheckResult		ret;
+			if(!alloc_tracker::available()) {
+				ret.reason.emplace("allocation tracker is not available (link libprotest_alloc)");
+				return	ret;
+			}
+			alloc_tracker::begin();
+			try {
+				m_fun(arg);
+			} catch(...) {
+				alloc_tracker::end();
+				throw;
+			}
+			const auto		stats = alloc_tracker::end();
+			if((stats.allocations > m_maxAllocations) || (stats.bytes > m_maxBytes)) {
+				ret.reason.emplace(std::to_string(stats.allocations) + " allocations ("
+						+ std::to_string(stats.bytes) + " bytes, peak " + std::to_string(stats.peakBytes)
+						+ " bytes) exceed the limit of " + std::to_string(m_maxAllocations) + " allocations"
+						+ ((m_maxBytes != SIZE_MAX) ? (" and " + std::to_string(m_maxBytes) + " bytes") : std::string()));
+			}
+			return	ret;
+		}
+}; // class AllocatesAtMost
+
+//! Check that the function never allocates for each case.
+template <typename Param>
+class	NoAllocation : public AllocatesAtMost<Param> {
+	public:
+		template <typename F>
+		NoAllocation(F &&f)
+		:AllocatesAtMost<Param>(std::forward<F>(f), 0, 0)
+		{}
+}; // class NoAllocation
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__ALLOC_TRACKER_HPP_
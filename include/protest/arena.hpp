@@ -0,0 +1,177 @@
+/*!
+ * \file   arena.hpp
+ * \brief  Monotonic memory arena for test cases.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__ARENA_HPP_
+#define	INCLUDED__NU11P0__PROTEST__ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace	nu11p0 {
+namespace	protest {
+
+//! Monotonic memory arena.
+/*!
+ * 確保はポインタを進めるだけで行い、個別の解放はしない。
+ * reset() で全ての領域をまとめて再利用可能にするが、確保済みのブロックは保持し続けるため、
+ * 二回目以降の実行ではシステムのアロケータは呼ばれない。
+ *
+ * SimpleTest はテスト実行(runTest)ごとにアリーナをリセットする。
+ * 放棄されたケースが使っている間は、 shared_ptr で保持して寿命を延ばす(detail::freshArena())。
+ */
+class	Arena {
+	private:
+		struct	Block {
+			Block			*next;
+			size_t			size;
+			char			*data(void) {
+				return	reinterpret_cast<char *>(this + 1);
+			}
+		};
+		//! 最初のブロック。ブロックは確保順に繋がっている。
+		Block			*m_head;
+		//! 現在確保に使っているブロック。
+		Block			*m_current;
+		char			*m_cur;
+		char			*m_end;
+		size_t			m_initialBlockSize;
+	public:
+		explicit		Arena(size_t initialBlockSize=64*1024) noexcept
+		:m_head()
+		,m_current()
+		,m_cur()
+		,m_end()
+		,m_initialBlockSize(initialBlockSize)
+		{}
+		~Arena();
+		Arena(const Arena &) = delete;
+		Arena			&operator=(const Arena &) = delete;
+		void			*allocate(size_t size, size_t align=alignof(std::max_align_t))
+		{
+			auto			p = reinterpret_cast<uintptr_t>(m_cur);
+			auto			aligned = (p + align - 1) & ~static_cast<uintptr_t>(align - 1);
+			if(m_cur && (aligned + size <= reinterpret_cast<uintptr_t>(m_end))) {
+				m_cur = reinterpret_cast<char *>(aligned + size);
+				return	reinterpret_cast<void *>(aligned);
+			}
+			return	allocateSlow(size, align);
+		}
+		//! Make all memory reusable. Blocks are kept.
+		void			reset(void) noexcept
+		{
+			m_current = m_head;
+			m_cur = m_head ? m_head->data() : nullptr;
+			m_end = m_head ? m_head->data() + m_head->size : nullptr;
+		}
+		//! Total bytes of blocks held by the arena.
+		size_t			capacity(void) const noexcept;
+	private:
+		void			*allocateSlow(size_t size, size_t align);
+}; // class Arena
+
+namespace	detail {
+	//! Arena for the next run, which nothing else refers to.
+	/*!
+	 * 他に所有者がいなければリセットして再利用し、
+	 * 放棄されたケースやテストの複製が参照していれば、それは残して新しく作る。
+	 */
+	inline Arena	&freshArena(std::shared_ptr<Arena> &arena)
+	{
+		if(arena && (arena.use_count() == 1)) {
+			arena->reset();
+		} else {
+			arena = std::make_shared<Arena>();
+		}
+		return	*arena;
+	}
+} // namespace detail
+
+//! Allocator which allocates from Arena.
+/*!
+ * アリーナを指定せずに構築した場合は、 ::operator new を使う。
+ * コピー構築されたコンテナはアリーナを引き継がない(通常のアロケータを使う)ため、
+ * テスト結果などに保存されたコピーはアリーナのリセット後も有効である。
+ */
+template <typename T>
+class	ArenaAllocator {
+	template <typename U> friend class	ArenaAllocator;
+	public:
+		using	value_type = T;
+		using	propagate_on_container_copy_assignment = std::false_type;
+		using	propagate_on_container_move_assignment = std::true_type;
+		using	propagate_on_container_swap = std::true_type;
+		template <typename U>
+		struct	rebind {
+			using	other = ArenaAllocator<U>;
+		};
+	private:
+		Arena			*m_arena;
+	public:
+		ArenaAllocator() noexcept
+		:m_arena()
+		{}
+		explicit		ArenaAllocator(Arena &arena) noexcept
+		:m_arena(&arena)
+		{}
+		template <typename U>
+		ArenaAllocator(const ArenaAllocator<U> &other) noexcept
+		:m_arena(other.m_arena)
+		{}
+		T				*allocate(size_t n)
+		{
+			if(m_arena) {
+				return	static_cast<T *>(m_arena->allocate(n * sizeof(T), alignof(T)));
+			}
+			return	static_cast<T *>(::operator new(n * sizeof(T)));
+		}
+		void			deallocate(T *p, size_t) noexcept
+		{
+			// アリーナから確保した領域は reset() でまとめて解放される。
+			if(!m_arena) {
+				::operator delete(p);
+			}
+		}
+		ArenaAllocator	select_on_container_copy_construction(void) const noexcept
+		{
+			return	ArenaAllocator();
+		}
+		Arena			*arena(void) const noexcept
+		{
+			return	m_arena;
+		}
+		template <typename U>
+		bool			operator==(const ArenaAllocator<U> &other) const noexcept
+		{
+			return	m_arena == other.m_arena;
+		}
+		template <typename U>
+		bool			operator!=(const ArenaAllocator<U> &other) const noexcept
+		{
+			return	m_arena != other.m_arena;
+		}
+}; // class ArenaAllocator
+
+template <typename T>
+struct	IsArenaAllocator : std::false_type {};
+template <typename T>
+struct	IsArenaAllocator<ArenaAllocator<T>> : std::true_type {};
+
+template <typename T>
+using	ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+template <typename Char=char>
+using	ArenaString = std::basic_string<Char, std::char_traits<Char>, ArenaAllocator<Char>>;
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__ARENA_HPP_
@@ -0,0 +1,307 @@
+/*!
+ * \file   async_test.hpp
+ * \brief  Test for properties which complete asynchronously.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__ASYNC_TEST_HPP_
+#define	INCLUDED__NU11P0__PROTEST__ASYNC_TEST_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+#include <protest/test_base.hpp>
+#ifndef	INCLUDED__NU11P0__PROTEST__ARENA_HPP_
+#	include <protest/arena.hpp>
+#endif
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#	include <coroutine>
+#	define	PROTEST_HAVE_COROUTINE_
+#endif
+
+namespace	nu11p0 {
+namespace	protest {
+
+#ifdef	PROTEST_HAVE_COROUTINE_
+//! Coroutine returning CheckResult, usable as a property of AsyncTest.
+/*!
+ * コルーチンは呼び出された時点で開始し(initial_suspendで中断しない)、
+ * co_return した結果は std::future<CheckResult> として受け取れる。
+ * コルーチンの再開(co_awaitの完了)は、待っているI/O等の側で行う。
+ *
+ * 使用例:
+ *     protest::AsyncTest<Request>	test("echo", [&](const Request &req) -> protest::CheckTask {
+ *         auto	res = co_await client.send(req);
+ *         co_return protest::AssertResult(res == req, "echo mismatch");
+ *     });
+ *
+ * C++20のコルーチンが使える場合のみ定義される。
+ */
+class	CheckTask {
+	public:
+		struct	promise_type {
+			std::promise<CheckResult>	promise;
+			CheckTask		get_return_object(void)
+			{
+				return	CheckTask(promise.get_future());
+			}
+			std::suspend_never	initial_suspend(void) noexcept
+			{
+				return	{};
+			}
+			// 完了したらフレームはそのまま破棄させる。結果はfutureに残る。
+			std::suspend_never	final_suspend(void) noexcept
+			{
+				return	{};
+			}
+			void			return_value(CheckResult res)
+			{
+				promise.set_value(std::move(res));
+			}
+			void			unhandled_exception(void)
+			{
+				promise.set_exception(std::current_exception());
+			}
+		};
+	private:
+		std::future<CheckResult>	m_future;
+		explicit		CheckTask(std::future<CheckResult> &&f)
+		:m_future(std::move(f))
+		{}
+	public:
+		CheckTask(CheckTask &&) = default;
+		CheckTask		&operator=(CheckTask &&) = default;
+		operator		std::future<CheckResult>()
+		{
+			return	std::move(m_future);
+		}
+}; // class CheckTask
+#endif	// ifdef PROTEST_HAVE_COROUTINE_
+
+//! Test for properties which return std::future<CheckResult>.
+/*!
+ * SimpleTest と同様に使えるが、性質はテストケースを受け取って std::future<CheckResult> を返す。
+ * (コルーチンが使える場合は CheckTask を返してもよい。)
+ * 同時に最大 maxInFlight() 個のテストケースを実行中にし、完了したものから結果を回収する。
+ * I/Oを待つような性質では、ケース一つ分の待ち時間ではなく、スループットでテストの時間が決まる。
+ *
+ * 失敗の扱いは SimpleTest と同じになるようにしている。
+ * 失敗が見つかったら新しいケースは開始せず、実行中のケースを全て待ってから、
+ * 生成された順番で最初に失敗したケースを failedCase とする。
+ * passCount はそれより前のケースの数となる。
+ *
+ * テストケースは完了するまで AsyncTest が保持しているので、性質は引数への参照を保持してよい。
+ */
+template <typename T>
+class	AsyncTest {
+	public:
+		using	param_type = T;
+	private:
+		//! 実行中のテストケース。
+		struct	Slot {
+			ns_optional::optional<param_type>	param;
+			std::future<CheckResult>	result;
+			//! 生成された順番(スキップは除く)。
+			size_t			index;
+		};
+		TestResult			m_result;
+		std::function<std::future<CheckResult>(const param_type &)>	m_fun;
+		std::function<bool(const param_type &)>	m_preCondition;
+		size_t			m_maxInFlight;
+		//! 空いている Slot を探す間隔。
+		std::chrono::microseconds	m_pollInterval;
+		//! m_slots は runTest() の間は再確保しないので、テストケースのアドレスは変わらない。
+		std::vector<Slot>	m_slots;
+		std::vector<size_t>	m_freeSlots;
+		std::shared_ptr<Arena>	m_arena;
+	public:
+		template <typename F>
+		AsyncTest(std::string &&a, F &&f)
+		:m_result()
+		,m_fun(std::forward<F>(f))
+		,m_preCondition()
+		,m_maxInFlight(16)
+		,m_pollInterval(100)
+		,m_slots()
+		,m_freeSlots()
+		,m_arena()
+		{
+			m_result.abstract = std::forward<std::string>(a);
+		}
+		template <typename F, typename PreCon>
+		AsyncTest(std::string &&a, F &&f, PreCon &&precon)
+		:m_result()
+		,m_fun(std::forward<F>(f))
+		,m_preCondition(precon)
+		,m_maxInFlight(16)
+		,m_pollInterval(100)
+		,m_slots()
+		,m_freeSlots()
+		,m_arena()
+		{
+			m_result.abstract = std::forward<std::string>(a);
+		}
+		void			clearError(void)
+		{
+			m_result.clearError();
+		}
+		void			clearAll(void)
+		{
+			m_result.clearAll();
+		}
+		Arena			&arena(void)
+		{
+			if(!m_arena) {
+				m_arena = std::make_shared<Arena>();
+			}
+			return	*m_arena;
+		}
+		//! Number of cases kept running at once.
+		size_t			maxInFlight(void) const
+		{
+			return	m_maxInFlight;
+		}
+		void			maxInFlight(size_t n)
+		{
+			m_maxInFlight = n ? n : 1;
+		}
+		//! Interval to wait for the oldest running case when none has completed.
+		void			pollInterval(std::chrono::microseconds interval)
+		{
+			m_pollInterval = interval;
+		}
+		// maxCountはskipも含めての数。
+		template <typename TCG>
+		const TestResult	&runTest(std::string &&caseDescription, TCG &&testcaseGenerator, size_t maxCount, std::ostream &ost=nullOstream())
+		{
+			bool			ostreamAvailable = isOstreamAvailable(ost);
+			if(m_result.isTestFailed()) {
+				// 以前のテストのエラー情報がクリアされていない。
+				return	m_result;
+			}
+			m_result.lastCaseDescription = std::forward<std::string>(caseDescription);
+			detail::bindArena(testcaseGenerator, detail::freshArena(m_arena));
+			if(!maxCount) {
+				return	m_result;
+			}
+			m_slots.clear();
+			m_slots.resize(m_maxInFlight);
+			m_freeSlots.clear();
+			for(size_t i = m_maxInFlight; i; --i) {
+				m_freeSlots.push_back(i - 1);
+			}
+			size_t			count = 0;
+			size_t			inFlight = 0;
+			size_t			issued = 0;
+			// 失敗したケースのうち、最も早く生成されたものの番号。
+			size_t			failedIndex = SIZE_MAX;
+			bool			stopped = false;
+			auto			startTime = std::chrono::steady_clock::now();
+			auto			prevTime = startTime;
+			bool			progressPrinted = false;
+			bool			hasPreCondition = static_cast<bool>(m_preCondition);
+			auto			&skipCount = m_result.skipCount;
+			const size_t	basePassCount = m_result.passCount;
+			for(;;) {
+				// 空いている Slot にケースを投入する。
+				while(!stopped && (inFlight < m_maxInFlight)) {
+					auto			&&c = testcaseGenerator();
+					if(!c) {
+						stopped = true;
+						break;
+					}
+					auto			&&param = c.value();
+					if(hasPreCondition && !m_preCondition(param)) {
+						++skipCount;
+						detail::recycleCase(testcaseGenerator, std::move(param));
+						continue;
+					}
+					auto			&slot = m_slots[m_freeSlots.back()];
+					m_freeSlots.pop_back();
+					slot.param.emplace(std::move(param));
+					slot.index = issued++;
+					slot.result = m_fun(slot.param.value());
+					++inFlight;
+					if(++count >= maxCount) {
+						stopped = true;
+					}
+				}
+				if(!inFlight) {
+					break;
+				}
+				// 完了したケースを一つ回収する。なければ最も古いケースを少し待つ。
+				size_t			ready = SIZE_MAX;
+				size_t			oldest = SIZE_MAX;
+				for(size_t i = 0; i < m_slots.size(); ++i) {
+					auto			&slot = m_slots[i];
+					if(!slot.param) {
+						continue;
+					}
+					if(slot.result.wait_for(std::chrono::seconds::zero()) != std::future_status::timeout) {
+						ready = i;
+						break;
+					}
+					if((oldest == SIZE_MAX) || (slot.index < m_slots[oldest].index)) {
+						oldest = i;
+					}
+				}
+				if(ready == SIZE_MAX) {
+					m_slots[oldest].result.wait_for(m_pollInterval);
+					continue;
+				}
+				auto			&slot = m_slots[ready];
+				CheckResult		res = slot.result.get();
+				--inFlight;
+				m_freeSlots.push_back(ready);
+				if(res.isTestFailed()) {
+					stopped = true;
+					if(slot.index < failedIndex) {
+						failedIndex = slot.index;
+						m_result.failedCase = std::move(slot.param.value());
+						m_result.reason = std::move(res.reason.value());
+					}
+				} else {
+					detail::recycleCase(testcaseGenerator, std::move(slot.param.value()));
+				}
+				slot.param = PROTEST_NULLOPT;
+#include <protest/loligger_sgr_macro.h>
+				if(ostreamAvailable) {
+					auto			nowTime = std::chrono::steady_clock::now();
+					if((nowTime - prevTime) >= std::chrono::milliseconds(500)) {
+						prevTime = nowTime;
+						ost << '\r' << "[" SGR(FG_YELLOW) "RUN" SGR(RESET) " ] done: " << (issued - inFlight) << ", in flight: " << inFlight << ", skip: " << skipCount << std::flush;
+						progressPrinted = true;
+					}
+				}
+			}
+			// 最初に失敗したケースより前のケースは全て成功している。
+			m_result.passCount = basePassCount + ((failedIndex == SIZE_MAX) ? issued : failedIndex);
+			auto			elapsed = std::chrono::steady_clock::now() - startTime;
+			m_result.elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+			detail::recordDistinctCount(testcaseGenerator, m_result);
+			if(progressPrinted) {
+				ost << '\r'
+					<< "[" SGR(FG_GREEN) "DONE" SGR(RESET) "] elapsed: "
+					<< std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()
+					<< "ms, pass: " << m_result.passCount << ", skip: " << skipCount << std::endl;
+			}
+#define	SGR_UNDEF
+#include <protest/loligger_sgr_macro.h>
+			return	m_result;
+		}
+}; // class AsyncTest
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__ASYNC_TEST_HPP_
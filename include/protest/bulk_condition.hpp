@@ -0,0 +1,445 @@
+/*!
+ * \file   bulk_condition.hpp
+ * \brief  Conditions on large arrays of arithmetic values, checked with vectorizable kernels.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__BULK_CONDITION_HPP_
+#define	INCLUDED__NU11P0__PROTEST__BULK_CONDITION_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+#ifndef	INCLUDED__NU11P0__PROTEST__EQUIVALENT_HPP_
+#	include <protest/equivalent.hpp>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace	nu11p0 {
+namespace	protest {
+
+//! Kernels of bulk conditions over contiguous arrays of arithmetic values.
+/*!
+ * 各カーネルは分岐の無い述語のブロック単位の論理和として書かれ、ベクトル化される
+ * ( detail::firstMismatchBlocked を参照)。違反が見つかったブロックの中だけを順に調べる。
+ */
+namespace	bulk {
+
+	//! Order checked by firstUnordered() and Monotone.
+	enum class	Order {
+		//! a[i] <= a[i+1]
+		Ascending,
+		//! a[i] < a[i+1]
+		StrictlyAscending,
+		//! a[i] >= a[i+1]
+		Descending,
+		//! a[i] > a[i+1]
+		StrictlyDescending,
+	};
+
+	namespace	detail {
+
+		template <typename T>
+		using	Acc = protest::detail::SameWidthUnsigned<T>;
+
+		//! True (1) if either is NaN. Always 0 for integers.
+		template <typename T>
+		auto			unordered(T a, T b)
+			-> std::enable_if_t<std::is_floating_point<T>::value, Acc<T>>
+		{
+			return	static_cast<Acc<T>>(std::isunordered(a, b));
+		}
+		template <typename T>
+		auto			unordered(T, T)
+			-> std::enable_if_t<!std::is_floating_point<T>::value, Acc<T>>
+		{
+			return	0;
+		}
+
+	} // namespace detail
+
+	//! Index i of the first pair (a[i], a[i+1]) out of the order, or n if none.
+	/*!
+	 * 浮動小数点数の NaN はどの順序にも違反するとみなす。
+	 */
+	template <typename T>
+	size_t			firstUnordered(const T *a, size_t n, Order order)
+	{
+		using	Acc = detail::Acc<T>;
+		if(n < 2) {
+			return	n;
+		}
+		size_t			i = n;
+		// 順序ごとにループを分け、ループ内に分岐が残らないようにする。
+		switch(order) {
+			case Order::Ascending:
+				i = protest::detail::firstMismatchBlocked<Acc>(n - 1, [a](size_t k) {
+						return	static_cast<Acc>((a[k + 1] < a[k]) | detail::unordered(a[k], a[k + 1]));
+					});
+				break;
+			case Order::StrictlyAscending:
+				i = protest::detail::firstMismatchBlocked<Acc>(n - 1, [a](size_t k) {
+						return	static_cast<Acc>(!(a[k] < a[k + 1]));
+					});
+				break;
+			case Order::Descending:
+				i = protest::detail::firstMismatchBlocked<Acc>(n - 1, [a](size_t k) {
+						return	static_cast<Acc>((a[k] < a[k + 1]) | detail::unordered(a[k], a[k + 1]));
+					});
+				break;
+			case Order::StrictlyDescending:
+				i = protest::detail::firstMismatchBlocked<Acc>(n - 1, [a](size_t k) {
+						return	static_cast<Acc>(!(a[k + 1] < a[k]));
+					});
+				break;
+		}
+		return	(i < n - 1) ? i : n;
+	}
+
+	//! Index of the first infinity or NaN, or n if none.
+	template <typename T>
+	auto			firstNonFinite(const T *a, size_t n)
+		-> std::enable_if_t<protest::detail::HasUlps<T>::value, size_t>
+	{
+		using	Acc = typename protest::detail::FloatBits<T>::bits_type;
+		constexpr Acc	infinity = protest::detail::FloatBits<T>::infinity;
+		// 指数部が全て1なら無限大か NaN 。
+		return	protest::detail::firstMismatchBlocked<Acc>(n, [a](size_t i) {
+				return	static_cast<Acc>((protest::detail::floatBits(a[i]) & infinity) == infinity);
+			});
+	}
+	template <typename T>
+	auto			firstNonFinite(const T *a, size_t n)
+		-> std::enable_if_t<!std::is_floating_point<T>::value, size_t>
+	{
+		static_cast<void>(a);
+		return	n;
+	}
+
+	//! Index of the first element out of [lower, upper] (or NaN), or n if none.
+	template <typename T>
+	size_t			firstOutOfRange(const T *a, size_t n, T lower, T upper)
+	{
+		using	Acc = detail::Acc<T>;
+		return	protest::detail::firstMismatchBlocked<Acc>(n, [a, lower, upper](size_t i) {
+				return	static_cast<Acc>((a[i] < lower) | (upper < a[i]) | detail::unordered(a[i], a[i]));
+			});
+	}
+
+	//! Order-independent hash of a multiset of values.
+	/*!
+	 * 各要素のビット列を64ビットの混合関数(splitmix64 の最終段)に通した値 h について、
+	 * h の和と h の二乗の和を 2^64 を法として求める。
+	 * 和は要素の順序に依らないので、並べ替えの前後で一致する。
+	 * 異なる多重集合が偶然に衝突する確率は、一つ目の和だけで 2^-64 程度であり、二つ目の和でさらに下がる。
+	 */
+	struct	MultisetHash {
+		size_t			count;
+		uint64_t		sum1;
+		uint64_t		sum2;
+		MultisetHash()
+		:count()
+		,sum1()
+		,sum2()
+		{}
+		bool			operator==(const MultisetHash &other) const {
+			return	(count == other.count) && (sum1 == other.sum1) && (sum2 == other.sum2);
+		}
+		bool			operator!=(const MultisetHash &other) const {
+			return	!(*this == other);
+		}
+	}; // struct MultisetHash
+
+	namespace	detail {
+
+		//! Finalizer of splitmix64.
+		inline uint64_t	mix64(uint64_t h)
+		{
+			h ^= h >> 30;
+			h *= 0xbf58476d1ce4e5b9u;
+			h ^= h >> 27;
+			h *= 0x94d049bb133111ebu;
+			h ^= h >> 31;
+			return	h;
+		}
+
+		//! Bits of the element, zero-extended to 64 bits.
+		template <typename T>
+		uint64_t		elementBits(const T &x)
+		{
+			std::conditional_t<(sizeof(T) == 1), uint8_t,
+				std::conditional_t<(sizeof(T) == 2), uint16_t,
+				std::conditional_t<(sizeof(T) == 4), uint32_t, uint64_t>>>	bits;
+			std::memcpy(&bits, &x, sizeof(bits));
+			return	bits;
+		}
+
+	} // namespace detail
+
+	template <typename T>
+	MultisetHash	multisetHash(const T *a, size_t n)
+	{
+		static_assert(std::is_arithmetic<T>::value && (sizeof(T) <= 8), "multisetHash() supports arithmetic types of up to 64 bits");
+		MultisetHash	ret;
+		uint64_t		sum1 = 0;
+		uint64_t		sum2 = 0;
+		const auto		add = [&sum1, &sum2](const T &x) {
+				const uint64_t	h = detail::mix64(detail::elementBits(x));
+				sum1 += h;
+				// 二つ目の和は、混合した値の二乗の和にする。
+				sum2 += h * h;
+			};
+		constexpr size_t	block = protest::detail::mismatchBlock;
+		size_t			begin = 0;
+		// firstMismatchBlocked と同じく、回数が定数のループにしてベクトル化させる。
+		for(; begin + block <= n; begin += block) {
+			for(size_t i = 0; i < block; ++i) {
+				add(a[begin + i]);
+			}
+		}
+		for(; begin < n; ++begin) {
+			add(a[begin]);
+		}
+		ret.count = n;
+		ret.sum1 = sum1;
+		ret.sum2 = sum2;
+		return	ret;
+	}
+
+} // namespace bulk
+
+namespace	detail {
+
+	//! Common part of bulk conditions: the array to check is the case itself, or the result of a function.
+	/*!
+	 * 関数を渡さなければ、ケースそのもの(コピーせずに)を検査する。
+	 * 関数の戻り値は一時オブジェクトとして参照で束縛し、コピーしない。
+	 */
+	template <typename Param, typename Result>
+	class	BulkConditionBase {
+		public:
+			using	param_type = Param;
+			using	result_type = Result;
+			using	element_type = std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<const Result &>().data())>>;
+			static_assert(std::is_arithmetic<element_type>::value, "bulk conditions require contiguous containers of arithmetic values");
+		private:
+			std::function<result_type(const param_type &)>	m_fun;
+			template <typename Check>
+			CheckResult		withResult(const param_type &arg, Check &check, std::true_type) {
+				return	m_fun ? check(m_fun(arg)) : check(arg);
+			}
+			template <typename Check>
+			CheckResult		withResult(const param_type &arg, Check &check, std::false_type) {
+				return	check(m_fun(arg));
+			}
+		protected:
+			BulkConditionBase()
+			:m_fun()
+			{
+				static_assert(std::is_same<param_type, result_type>::value, "give the function which converts the case");
+			}
+			template <typename F>
+			explicit BulkConditionBase(F &&f)
+			:m_fun(std::forward<F>(f))
+			{}
+			//! Call check(array) with the array to check.
+			template <typename Check>
+			CheckResult		withResult(const param_type &arg, Check &&check) {
+				return	withResult(arg, check, std::is_same<param_type, result_type>{});
+			}
+	}; // class BulkConditionBase
+
+} // namespace detail
+
+//! Check that the array is monotone in the given order.
+template <typename Param, typename Result=Param>
+class	Monotone : public detail::BulkConditionBase<Param, Result> {
+	private:
+		using	base_type = detail::BulkConditionBase<Param, Result>;
+		bulk::Order		m_order;
+	public:
+		using	typename base_type::param_type;
+		using	typename base_type::result_type;
+		//! Check the case itself.
+		explicit Monotone(bulk::Order order)
+		:base_type()
+		,m_order(order)
+		{}
+		template <typename F>
+		Monotone(F &&f, bulk::Order order)
+		:base_type(std::forward<F>(f))
+		,m_order(order)
+		{}
+		CheckResult		operator()(const param_type &arg)
+		{
+			return	this->withResult(arg, [this](const result_type &a) {
+					CheckResult		ret;
+					const size_t	n = a.size();
+					const size_t	i = bulk::firstUnordered(a.data(), n, m_order);
+					if(i < n) {
+						static const char	*const names[] = {"ascending", "strictly ascending", "descending", "strictly descending"};
+						ret.reason.emplace(std::string("not ") + names[static_cast<int>(m_order)] + " at index " + std::to_string(i)
+								+ ": " + detail::describeValue(a.data()[i]) + ", " + detail::describeValue(a.data()[i + 1]));
+					}
+					return	ret;
+				});
+		}
+}; // class Monotone
+
+//! Check that the array is sorted in ascending order (non-decreasing).
+template <typename Param, typename Result=Param>
+class	BulkSorted : public Monotone<Param, Result> {
+	public:
+		BulkSorted()
+		:Monotone<Param, Result>(bulk::Order::Ascending)
+		{}
+		template <typename F>
+		explicit BulkSorted(F &&f)
+		:Monotone<Param, Result>(std::forward<F>(f), bulk::Order::Ascending)
+		{}
+}; // class BulkSorted
+
+//! Check that no element is infinity or NaN.
+template <typename Param, typename Result=Param>
+class	AllFinite : public detail::BulkConditionBase<Param, Result> {
+	private:
+		using	base_type = detail::BulkConditionBase<Param, Result>;
+	public:
+		using	typename base_type::param_type;
+		using	typename base_type::result_type;
+		AllFinite()
+		:base_type()
+		{}
+		template <typename F>
+		explicit AllFinite(F &&f)
+		:base_type(std::forward<F>(f))
+		{}
+		CheckResult		operator()(const param_type &arg)
+		{
+			return	this->withResult(arg, [](const result_type &a) {
+					CheckResult		ret;
+					const size_t	i = bulk::firstNonFinite(a.data(), a.size());
+					if(i < a.size()) {
+						ret.reason.emplace("element " + std::to_string(i) + " is not finite: " + detail::describeValue(a.data()[i]));
+					}
+					return	ret;
+				});
+		}
+}; // class AllFinite
+
+//! Check that every element is in [lower, upper].
+template <typename Param, typename Result=Param>
+class	Bounded : public detail::BulkConditionBase<Param, Result> {
+	private:
+		using	base_type = detail::BulkConditionBase<Param, Result>;
+	public:
+		using	typename base_type::param_type;
+		using	typename base_type::result_type;
+		using	typename base_type::element_type;
+	private:
+		element_type	m_lower;
+		element_type	m_upper;
+	public:
+		Bounded(element_type lower, element_type upper)
+		:base_type()
+		,m_lower(lower)
+		,m_upper(upper)
+		{}
+		template <typename F>
+		Bounded(F &&f, element_type lower, element_type upper)
+		:base_type(std::forward<F>(f))
+		,m_lower(lower)
+		,m_upper(upper)
+		{}
+		CheckResult		operator()(const param_type &arg)
+		{
+			return	this->withResult(arg, [this](const result_type &a) {
+					CheckResult		ret;
+					const size_t	i = bulk::firstOutOfRange(a.data(), a.size(), m_lower, m_upper);
+					if(i < a.size()) {
+						ret.reason.emplace("element " + std::to_string(i) + " is out of ["
+								+ detail::describeValue(m_lower) + ", " + detail::describeValue(m_upper) + "]: "
+								+ detail::describeValue(a.data()[i]));
+					}
+					return	ret;
+				});
+		}
+}; // class Bounded
+
+namespace	detail {
+
+	//! Describe the first value whose count differs between two arrays. Called only on failure.
+	template <typename T>
+	std::string		describeMultisetDifference(const T *input, size_t inputSize, const T *output, size_t outputSize)
+	{
+		if(inputSize != outputSize) {
+			return	"size differs: input " + std::to_string(inputSize) + ", output " + std::to_string(outputSize);
+		}
+		// 失敗時だけなので、コピーして並べ替えて比べる。 NaN も比べられるようビット列で並べる。
+		using	bits_type = SameWidthUnsigned<T>;
+		std::vector<bits_type>	a(inputSize);
+		std::vector<bits_type>	b(outputSize);
+		std::memcpy(a.data(), input, inputSize * sizeof(T));
+		std::memcpy(b.data(), output, outputSize * sizeof(T));
+		std::sort(a.begin(), a.end());
+		std::sort(b.begin(), b.end());
+		const auto		diff = std::mismatch(a.begin(), a.end(), b.begin());
+		if(diff.first == a.end()) {
+			return	"multiset hash collision";
+		}
+		// 小さい方の値が、もう一方より多く含まれている。
+		const bits_type	bits = std::min(*diff.first, *diff.second);
+		T				value;
+		std::memcpy(&value, &bits, sizeof(value));
+		const auto		countA = std::count(a.begin(), a.end(), bits);
+		const auto		countB = std::count(b.begin(), b.end(), bits);
+		return	"value " + describeValue(value) + " occurs " + std::to_string(countA) + " times in the input and "
+				+ std::to_string(countB) + " times in the output";
+	}
+
+} // namespace detail
+
+//! Check that the result of the function is a permutation of the case.
+/*!
+ * 入力と出力の MultisetHash を比べるので、要素を並べ替えたりコピーしたりせずに検査できる。
+ * 失敗した場合だけ、理由を作るために両方をコピーして並べ替える。
+ */
+template <typename Param, typename Result=Param>
+class	PermutationOf : public detail::BulkConditionBase<Param, Result> {
+	private:
+		using	base_type = detail::BulkConditionBase<Param, Result>;
+	public:
+		using	typename base_type::param_type;
+		using	typename base_type::result_type;
+		using	typename base_type::element_type;
+		template <typename F>
+		explicit PermutationOf(F &&f)
+		:base_type(std::forward<F>(f))
+		{}
+		CheckResult		operator()(const param_type &arg)
+		{
+			static_assert(std::is_same<std::remove_cv_t<std::remove_reference_t<decltype(*arg.data())>>, element_type>::value,
+					"PermutationOf requires the same element type for the case and the result");
+			return	this->withResult(arg, [&arg](const result_type &a) {
+					CheckResult		ret;
+					if(bulk::multisetHash(arg.data(), arg.size()) != bulk::multisetHash(a.data(), a.size())) {
+						ret.reason.emplace("output is not a permutation of the input: "
+								+ detail::describeMultisetDifference(arg.data(), arg.size(), a.data(), a.size()));
+					}
+					return	ret;
+				});
+		}
+}; // class PermutationOf
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__BULK_CONDITION_HPP_
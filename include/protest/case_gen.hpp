@@ -12,9 +12,20 @@
 #ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
 #	include <protest/protest_common.hpp>
 #endif
+#ifndef	INCLUDED__NU11P0__PROTEST__ARENA_HPP_
+#	include <protest/arena.hpp>
+#endif
 
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <random>
+#include <sstream>
 #include <iterator>
+#include <string>
+#include <vector>
 
 namespace	nu11p0 {
 namespace	protest {
@@ -31,70 +42,95 @@ struct	None {
 template <typename T, typename=void>
 class	Random;
 
+namespace	detail {
+	//! Default engine of Random: std::mt19937 or std::mt19937_64.
+	template <typename T>
+	using	RandomEngine = std::conditional_t<(sizeof(T) > 4), std::mt19937_64, std::mt19937>;
+	//! Default distribution of Random.
+	template <typename T, typename=void>
+	struct	RandomDistribution;
+	template <typename T>
+	struct	RandomDistribution<T, std::enable_if_t<std::is_integral<T>::value>> {
+		// std::mt19937 等の生成する値は、unsignedな型しか指定できない。
+		// よって、signedな値も欲しい場合はキャスト等してやらなければならない。
+		// ここでは、とりあえずキャストでなく分布を弄ることで対処した。
+		using	type = std::uniform_int_distribution<T>;
+		static type		make(void) {
+			// デフォルトでは0からmax()までなので、明示的にmin()からにする
+			return	type(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+		}
+	};
+	// FIXME: デフォルトで生成される数の種類(正規化数、非正規化数、[0.0, 1.0], [0.0, 1.0), NaN, etc...)の指定をさせるなり、
+	//        初めから範囲を明確にしておくなり、しっかりした仕様が必要かと。
+	//        特に、default ctorで初期化された場合に汎用的に使える必要がある(正規化数が良いか？)
+	//        とりあえず今のところは、[0.0, 1.0)で実装しとくけど、至急修正すること。
+	template <typename T>
+	struct	RandomDistribution<T, std::enable_if_t<std::is_floating_point<T>::value>> {
+		// std::mt19937 等の生成する値は、unsignedな整数型しか指定できない。
+		// よって、浮動小数点数が欲しい場合は分布を指定してやる。
+		using	type = std::uniform_real_distribution<T>;
+		static type		make(void) {
+			return	type();
+		}
+	};
+} // namespace detail
+
 template <typename T>
-class	Random<T, std::enable_if_t<std::is_integral<T>::value>> {
+class	Random<T, std::enable_if_t<(std::is_integral<T>::value || std::is_floating_point<T>::value)>> {
 	private:
+		using	engine_type = detail::RandomEngine<T>;
+		using	distribution_type = typename detail::RandomDistribution<T>::type;
+		//! 指定された生成器。空なら m_engine と m_dist を使う。
 		std::function<T()>	m_rng;
+		engine_type		m_engine;
+		distribution_type	m_dist;
 	public:
 		//! Use std::mt19937 or std::mt19937_64 as default pseudo-random number generator.
 		Random()
-		:m_rng(
-				// std::mt19937 等の生成する値は、unsignedな型しか指定できない。
-				// よって、signedな値も欲しい場合はキャスト等してやらなければならない。
-				// ここでは、とりあえずキャストでなく分布を弄ることで対処した。
-				[
-					// デフォルトでは0からmax()までなので、明示的にmin()からにする
-					dist=std::uniform_int_distribution<T>(std::numeric_limits<T>::min(), std::numeric_limits<T>::max())
-					, engine=std::conditional_t<(sizeof(T) > 4), std::mt19937_64, std::mt19937>(std::random_device()())
-				]() mutable {
-					return	dist(engine);
-				}
-			)
+		:Random(static_cast<uint64_t>(std::random_device()()))
+		{}
+		//! Use the default generator with the given seed.
+		explicit Random(uint64_t seed)
+		:m_rng()
+		,m_engine(static_cast<typename engine_type::result_type>(seed))
+		,m_dist(detail::RandomDistribution<T>::make())
 		{}
 		//! Use given (pseudo-)random number generator.
 		/*!
 		 * rngにはdistributionまで含めて指定してくんろー
 		 */
-		template <typename U>
+		template <typename U, typename=std::enable_if_t<!std::is_integral<std::decay_t<U>>::value>>
 		Random(U &&rng)
 		:m_rng(std::forward<U>(rng))
+		,m_engine()
+		,m_dist()
 		{}
 		~Random() = default;
+		// 宣言しておかないと、ムーブ時に上のテンプレートコンストラクタが選ばれてしまう。
+		Random(const Random &) = default;
+		Random(Random &&) = default;
 		ns_optional::optional<T>	operator()(void) {
-			return	ns_optional::make_optional<T>(m_rng());
+			return	ns_optional::make_optional<T>(m_rng ? m_rng() : m_dist(m_engine));
 		}
-}; // class Random
-
-// FIXME: デフォルトで生成される数の種類(正規化数、非正規化数、[0.0, 1.0], [0.0, 1.0), NaN, etc...)の指定をさせるなり、
-//        初めから範囲を明確にしておくなり、しっかりした仕様が必要かと。
-//        特に、default ctorで初期化された場合に汎用的に使える必要がある(正規化数が良いか？)
-//        とりあえず今のところは、[0.0, 1.0)で実装しとくけど、至急修正すること。
-template <typename T>
-class	Random<T, std::enable_if_t<std::is_floating_point<T>::value>> {
-	private:
-		std::function<T()>	m_rng;
-	public:
-		//! Use std::mt19937 or std::mt19937_64 as default pseudo-random number generator.
-		Random()
-		:m_rng(
-				// std::mt19937 等の生成する値は、unsignedな整数型しか指定できない。
-				// よって、浮動小数点数が欲しい場合は分布を指定してやる。
-				[
-					dist=std::uniform_real_distribution<T>()
-					, engine=std::conditional_t<(sizeof(T) > 4), std::mt19937_64, std::mt19937>(std::random_device()())
-				]() mutable {
-					return	dist(engine);
-				}
-			)
-		{}
-		//! Use given (pseudo-)random number generator.
-		template <typename U>
-		Random(U &&rng)
-		:m_rng(std::forward<U>(rng))
-		{}
-		~Random() = default;
-		ns_optional::optional<T>	operator()(void) {
-			return	ns_optional::make_optional<T>(m_rng());
+		//! Serialize the position of the default generator.
+		/*!
+		 * 指定された生成器を使っている場合は、状態を取り出せないので false を返す。
+		 */
+		bool			saveState(std::string &state) const {
+			if(m_rng) {
+				return	false;
+			}
+			std::ostringstream	oss;
+			oss << m_engine << ' ' << m_dist;
+			state = oss.str();
+			return	true;
+		}
+		bool			loadState(const std::string &state) {
+			if(m_rng) {
+				return	false;
+			}
+			std::istringstream	iss(state);
+			return	static_cast<bool>(iss >> m_engine >> m_dist);
 		}
 }; // class Random
 
@@ -110,22 +146,51 @@ class	IterableSource {
 	protected:
 		iterator_type	m_it;
 		iterator_type	m_ite;
+		//! 取り出した要素の数。
+		size_t			m_consumed;
 	public:
 		IterableSource()
 		:m_it()
 		,m_ite()
+		,m_consumed()
 		{}
 		IterableSource(const Container &obj)
 		:m_it(cbegin(obj))
 		,m_ite(cend(obj))
+		,m_consumed()
 		{}
 		~IterableSource() = default;
 		IterableSource(const IterableSource &) = default;
 		IterableSource(IterableSource &&) = default;
 		ns_optional::optional<value_type>	operator()(void) {
+			if(m_it == m_ite) {
+				return	PROTEST_NULLOPT;
+			}
+			++m_consumed;
 			// 返す値はコピーで作る。
 			// make_optional()はforwardしようとするため、*m_it++がconst参照を返すときエラーになる。
-			return	(m_it != m_ite) ? ns_optional::optional<value_type>(*m_it++) : PROTEST_NULLOPT;
+			return	ns_optional::optional<value_type>(*m_it++);
+		}
+		//! Serialize the position (the number of elements taken).
+		bool			saveState(std::string &state) const {
+			state = std::to_string(m_consumed);
+			return	true;
+		}
+		//! Skip to the saved position.
+		/*!
+		 * 入力イテレータでも使えるよう、現在位置から進めるだけなので、保存した位置より前にいること。
+		 */
+		bool			loadState(const std::string &state) {
+			std::istringstream	iss(state);
+			size_t			pos;
+			if(!(iss >> pos) || (pos < m_consumed)) {
+				return	false;
+			}
+			while((m_consumed < pos) && (m_it != m_ite)) {
+				++m_it;
+				++m_consumed;
+			}
+			return	m_consumed == pos;
 		}
 }; // class IterableSource
 
@@ -211,7 +276,8 @@ class	Edge<T, std::enable_if_t<(std::is_integral<T>{} && std::is_unsigned<T>{})>
 			limits::max()-1,
 			static_cast<T>(signed_limits::max()),
 			static_cast<T>(signed_limits::max()-1),
-			static_cast<T>(signed_limits::max()+1)
+			// 符号付きの max()+1 はオーバーフローするので、符号なしで計算する。
+			static_cast<T>(static_cast<std::make_unsigned_t<T>>(signed_limits::max()) + 1u)
 		}
 		{}
 		~Edge() = default;
@@ -272,6 +338,380 @@ class	Edge<T, std::enable_if_t<(std::is_floating_point<T>{})>> : public Pool<std
 		Edge(Edge &&) = default;
 }; // class Edge
 
+//! Generator of every value of the type, in the order of the bit patterns.
+/*!
+ * 整数型は0から最大値まで、続いて(符号付きなら)最小値から-1まで。
+ * 浮動小数点数型は全てのビットパターン(非正規化数、無限大、全てのNaNを含む)。
+ * 位置は数えた値の個数だけなので、状態の保存と復元が安価にできる。
+ * 64ビットを超える型(long double等)には使えない。
+ */
+template <typename T>
+class	Exhaustive {
+	static_assert((std::is_integral<T>::value || std::is_floating_point<T>::value) && (sizeof(T) <= sizeof(uint64_t)),
+			"Exhaustive supports arithmetic types of 64 bits or less");
+	public:
+		using	value_type = T;
+	private:
+		static constexpr int	bits = std::is_integral<T>::value
+				? (std::numeric_limits<T>::digits + std::numeric_limits<T>::is_signed)
+				: static_cast<int>(sizeof(T) * CHAR_BIT);
+		//! 最後のビットパターン。
+		static constexpr uint64_t	last = (bits >= 64) ? UINT64_MAX : ((static_cast<uint64_t>(1) << (bits % 64)) - 1);
+		uint64_t		m_next;
+		bool			m_done;
+		template <typename U=T>
+		static auto		fromBits(uint64_t pattern)
+			-> std::enable_if_t<std::is_integral<U>::value, U>
+		{
+			return	static_cast<U>(pattern);
+		}
+		template <typename U=T>
+		static auto		fromBits(uint64_t pattern)
+			-> std::enable_if_t<std::is_floating_point<U>::value, U>
+		{
+			using	bits_type = std::conditional_t<(sizeof(U) > 4), uint64_t, uint32_t>;
+			static_assert(sizeof(bits_type) == sizeof(U), "unsupported floating point type");
+			const bits_type	b = static_cast<bits_type>(pattern);
+			U				val;
+			std::memcpy(&val, &b, sizeof(val));
+			return	val;
+		}
+	public:
+		Exhaustive()
+		:m_next()
+		,m_done(false)
+		{}
+		~Exhaustive() = default;
+		Exhaustive(const Exhaustive &) = default;
+		Exhaustive(Exhaustive &&) = default;
+		ns_optional::optional<value_type>	operator()(void) {
+			if(m_done) {
+				return	PROTEST_NULLOPT;
+			}
+			const value_type	val = fromBits(m_next);
+			if(m_next == last) {
+				m_done = true;
+			} else {
+				++m_next;
+			}
+			return	ns_optional::optional<value_type>(val);
+		}
+		bool			saveState(std::string &state) const {
+			state = std::to_string(m_next) + ' ' + (m_done ? '1' : '0');
+			return	true;
+		}
+		bool			loadState(const std::string &state) {
+			std::istringstream	iss(state);
+			uint64_t		next;
+			bool			done;
+			if(!(iss >> next >> done) || (next > last)) {
+				return	false;
+			}
+			m_next = next;
+			m_done = done;
+			return	true;
+		}
+}; // class Exhaustive
+
+namespace	detail {
+	//! Exact set of values of a small integer type.
+	class	SeenBitmap {
+		private:
+			std::vector<uint64_t>	m_bits;
+		public:
+			//! The keys must be less than domain.
+			explicit SeenBitmap(size_t domain);
+			//! Insert the key. Returns false if it was already inserted.
+			bool			insert(size_t key);
+	}; // class SeenBitmap
+
+	//! Approximate set of hash values, which grows beyond the capacity.
+	/*!
+	 * 偽陽性があるため、初出の値を既出とみなして読み飛ばすことがある(既出の値を初出とみなすことはない)。
+	 * 最初の層は capacity 個を入れたときの偽陽性率がおよそ1%になるよう、1要素あたり10ビットと7個のハッシュを使う。
+	 * 層が満杯になると、容量が2倍で1要素あたりのビット数を増やした層を追加する(Scalable Bloom filter)。
+	 * 各層の偽陽性率は等比的に小さくなるので、いくつ入れても全体の偽陽性率は約1%に留まる。
+	 */
+	class	BloomFilter {
+		private:
+			struct	Layer {
+				std::vector<uint64_t>	bits;
+				uint64_t		mask;
+				size_t			capacity;
+				size_t			count;
+			};
+			std::vector<Layer>	m_layers;
+			void			addLayer(size_t capacity, size_t bitsPerElement);
+		public:
+			explicit BloomFilter(size_t capacity);
+			//! Insert the hash value. Returns false if it was (probably) already inserted.
+			bool			insert(uint64_t hash);
+			//! Number of layers added so far.
+			size_t			layers(void) const {
+				return	m_layers.size();
+			}
+	}; // class BloomFilter
+
+	//! Set of generated values for Unique: Bloom filter by default.
+	template <typename T, typename Hash, typename=void>
+	class	SeenFilter {
+		private:
+			BloomFilter		m_filter;
+			Hash			m_hash;
+		public:
+			explicit SeenFilter(size_t capacity)
+			:m_filter(capacity)
+			,m_hash()
+			{}
+			bool			insert(const T &val) {
+				return	m_filter.insert(static_cast<uint64_t>(m_hash(val)));
+			}
+			//! Number of values of the type. SIZE_MAX if unknown.
+			static constexpr size_t	domain(void) {
+				return	SIZE_MAX;
+			}
+	}; // class SeenFilter
+
+	//! Exact bitmap for integral types of 16 bits or less.
+	template <typename T, typename Hash>
+	class	SeenFilter<T, Hash, std::enable_if_t<(std::is_integral<T>{} && (std::numeric_limits<T>::digits + std::numeric_limits<T>::is_signed <= 16))>> {
+		private:
+			SeenBitmap		m_bitmap;
+		public:
+			explicit SeenFilter(size_t)
+			:m_bitmap(domain())
+			{}
+			bool			insert(const T &val) {
+				// 負の値も、下位ビットを取れば値の数未満の添字になる。
+				return	m_bitmap.insert(static_cast<size_t>(val) & (domain() - 1));
+			}
+			static constexpr size_t	domain(void) {
+				return	static_cast<size_t>(1) << (std::numeric_limits<T>::digits + std::numeric_limits<T>::is_signed);
+			}
+	}; // class SeenFilter
+} // namespace detail
+
+//! Generator which skips cases already generated.
+/*!
+ * 16ビット以下の整数型は正確なビットマップで、それ以外は Bloom filter で既出の値を覚えておく。
+ * 次のいずれかで飽和したとみなし、以降は PROTEST_NULLOPT を返してテストを早く終わらせる。
+ * - 型の全ての値を生成した。
+ * - maxRetries 回続けて既出の値が生成された(生成器の届く範囲を網羅したとみなす)。
+ *   ビットマップの型では、残りの値が少ないほど一様な生成器でも当たりにくいので、
+ *   残りの値を引くまでの期待回数の retryScale 倍までは続ける。
+ * Bloom filter は capacity を超えると層を足して大きくなり、偽陽性率は約1%を保つので、
+ * 偽陽性だけで maxRetries 回続くことはまず無い。
+ * 重複を除いたケースの数は TestResult::distinctCount に記録される。
+ * Bloom filter を使う型は、 Hash で64ビットのハッシュ値を計算できなければならない。
+ */
+template <typename T, typename Gen=Random<T>, typename Hash=std::hash<T>>
+class	Unique {
+	public:
+		using	value_type = T;
+	private:
+		Gen				m_gen;
+		detail::SeenFilter<T, Hash>	m_seen;
+		size_t			m_distinct;
+		size_t			m_maxRetries;
+		bool			m_saturated;
+	public:
+		Unique()
+		:Unique(Gen())
+		{}
+		//! capacity: Bloom filter の最初の層で覚えておく値の数。超えると、より大きな層を追加する。
+		explicit Unique(Gen gen, size_t maxRetries=1024, size_t capacity=(1u << 20))
+		:m_gen(std::move(gen))
+		,m_seen(capacity)
+		,m_distinct()
+		,m_maxRetries(maxRetries)
+		,m_saturated(false)
+		{}
+		~Unique() = default;
+		Unique(const Unique &) = default;
+		Unique(Unique &&) = default;
+		//! Multiple of the expected draws to find one of the remaining values of a known domain.
+		static constexpr size_t	retryScale = 16;
+		ns_optional::optional<value_type>	operator()(void) {
+			for(size_t retries = 0; !m_saturated; ) {
+				if(m_distinct >= m_seen.domain()) {
+					m_saturated = true;
+					break;
+				}
+				auto			&&c = m_gen();
+				if(!c) {
+					break;
+				}
+				if(m_seen.insert(c.value())) {
+					++m_distinct;
+					return	ns_optional::optional<value_type>(std::move(c.value()));
+				}
+				if(++retries >= retryLimit()) {
+					m_saturated = true;
+				}
+			}
+			return	PROTEST_NULLOPT;
+		}
+		//! Number of distinct cases generated so far.
+		size_t			distinctCount(void) const {
+			return	m_distinct;
+		}
+	private:
+		size_t			retryLimit(void) const {
+			const size_t	domain = m_seen.domain();
+			if(domain == SIZE_MAX) {
+				return	m_maxRetries;
+			}
+			// 一様な生成器なら、 domain / remaining 回に1回は新しい値が出る。
+			const size_t	remaining = domain - m_distinct;
+			return	std::max(m_maxRetries, retryScale * (domain / remaining));
+		}
+	public:
+		//! True if the generator stopped because no new case was found.
+		bool			saturated(void) const {
+			return	m_saturated;
+		}
+}; // class Unique
+
+//! Size parameter which grows with the number of generated cases (QuickCheck style).
+/*!
+ * 最初は小さいケースから始め、rampCases個のケースを生成するまでに線形にmaxSizeまで増やす。
+ */
+class	SizeSchedule {
+	private:
+		size_t			m_maxSize;
+		size_t			m_rampCases;
+		size_t			m_count;
+	public:
+		SizeSchedule(size_t maxSize, size_t rampCases)
+		:m_maxSize(maxSize)
+		,m_rampCases(rampCases)
+		,m_count()
+		{}
+		~SizeSchedule() = default;
+		SizeSchedule(const SizeSchedule &) = default;
+		SizeSchedule(SizeSchedule &&) = default;
+		size_t			maxSize(void) const {
+			return	m_maxSize;
+		}
+		//! Current upper bound of the size.
+		size_t			current(void) const {
+			if(m_count >= m_rampCases) {
+				return	m_maxSize;
+			}
+			return	static_cast<size_t>(static_cast<long double>(m_maxSize) * (m_count+1) / m_rampCases);
+		}
+		//! Current upper bound of the size, and advance the schedule.
+		size_t			next(void) {
+			size_t			ret = current();
+			++m_count;
+			return	ret;
+		}
+}; // class SizeSchedule
+
+//! Container of random length, whose elements are generated by ElemGen.
+/*!
+ * 長さは [0, 現在のサイズ上限] から一様に選ばれ、サイズ上限は SizeSchedule に従って大きくなっていく。
+ *
+ * runTest() は使い終わったテストケースを recycle() で生成器に返すので、
+ * 次のケースはそのバッファ(clear()しても容量は残る)を再利用して作られる。
+ * よって、定常状態ではケースごとのメモリ確保・解放は発生しない。
+ */
+template <typename Container, typename ElemGen=Random<typename Container::value_type>>
+class	Sized {
+	public:
+		using	value_type = Container;
+		using	element_type = typename Container::value_type;
+	private:
+		//! 再利用のために保持しておくバッファの最大数。
+		static constexpr size_t	maxFreeBuffers = 4;
+		using	allocator_type = typename Container::allocator_type;
+		SizeSchedule	m_schedule;
+		ElemGen			m_elemGen;
+		std::vector<Container>	m_free;
+		std::mt19937_64	m_engine;
+		allocator_type	m_allocator;
+	public:
+		//! Sizes grow up to 100 over the first 100 cases.
+		Sized()
+		:Sized(100, 100)
+		{}
+		Sized(size_t maxSize, size_t rampCases, ElemGen &&elemGen=ElemGen())
+		:m_schedule(maxSize, rampCases)
+		,m_elemGen(std::forward<ElemGen>(elemGen))
+		,m_free()
+		,m_engine(std::random_device()())
+		,m_allocator()
+		{}
+		~Sized() = default;
+		Sized(const Sized &) = default;
+		Sized(Sized &&) = default;
+		ns_optional::optional<value_type>	operator()(void) {
+			size_t			bound = m_schedule.next();
+			return	ns_optional::optional<value_type>(generate(std::uniform_int_distribution<size_t>(0, bound)(m_engine)));
+		}
+		//! Generate a container of exactly the given size (or shorter if ElemGen is exhausted).
+		value_type		generate(size_t size) {
+			value_type		c(m_allocator);
+			if(!m_free.empty()) {
+				c = std::move(m_free.back());
+				m_free.pop_back();
+				c.clear();
+			}
+			for(size_t i = 0; i < size; ++i) {
+				auto			&&elem = m_elemGen();
+				if(!elem) {
+					break;
+				}
+				c.insert(c.end(), std::move(elem.value()));
+			}
+			return	c;
+		}
+		//! Give a used case back to the generator for reuse of its storage.
+		void			recycle(value_type &&c) {
+			if(m_free.size() < maxFreeBuffers) {
+				m_free.push_back(std::move(c));
+			}
+		}
+		//! Allocate cases from the arena (only if Container uses ArenaAllocator).
+		/*!
+		 * runTest() から呼ばれる。再利用待ちのバッファは前回のアリーナのものなので捨てる。
+		 */
+		template <typename Alloc=allocator_type>
+		auto			bindArena(Arena &arena)
+			-> std::enable_if_t<IsArenaAllocator<Alloc>::value>
+		{
+			m_free.clear();
+			m_allocator = allocator_type(arena);
+		}
+		const SizeSchedule	&schedule(void) const {
+			return	m_schedule;
+		}
+}; // class Sized
+
+template <typename T, typename ElemGen=Random<T>>
+using	SizedVector = Sized<std::vector<T>, ElemGen>;
+
+template <typename Char=char, typename ElemGen=Random<Char>>
+using	SizedString = Sized<std::basic_string<Char>, ElemGen>;
+
+//! Byte buffers of random length.
+using	Bytes = SizedVector<uint8_t>;
+
+//! SizedVector whose cases are allocated from the arena of the test.
+template <typename T, typename ElemGen=Random<T>>
+using	ArenaSizedVector = Sized<ArenaVector<T>, ElemGen>;
+
+// 標準の算術型についての実体は libprotest にある(instantiations.cpp)。
+#ifndef	PROTEST_NO_EXTERN_TEMPLATES
+#	define	PROTEST_EXTERN_CASE_GEN_(T) \
+	extern template class Random<T>; \
+	extern template class IterableSource<std::vector<T>>; \
+	extern template class Pool<std::vector<T>>; \
+	extern template class Edge<T>;
+PROTEST_FOR_EACH_ARITHMETIC_TYPE(PROTEST_EXTERN_CASE_GEN_)
+#	undef	PROTEST_EXTERN_CASE_GEN_
+#endif
+
 } // namespace case_gen
 
 namespace	generic {
@@ -282,6 +722,16 @@ using	Random = case_gen::Random<T>;
 template <typename T>
 using	Edge = case_gen::Edge<T>;
 
+template <typename T>
+using	Unique = case_gen::Unique<T>;
+
+template <typename T>
+using	Exhaustive = case_gen::Exhaustive<T>;
+
+//! Use as `generic::test<generic::Sized, std::tuple<std::vector<int>, std::string>>(...)'.
+template <typename Container>
+using	Sized = case_gen::Sized<Container>;
+
 } // namespace generic
 
 } // namespace protest
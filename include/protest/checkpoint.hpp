@@ -0,0 +1,57 @@
+/*!
+ * \file   checkpoint.hpp
+ * \brief  Checkpoint files for resuming long test runs.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__CHECKPOINT_HPP_
+#define	INCLUDED__NU11P0__PROTEST__CHECKPOINT_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+
+#include <chrono>
+#include <string>
+
+namespace	nu11p0 {
+namespace	protest {
+
+//! Progress of a runTest() saved to a checkpoint file.
+struct	Checkpoint {
+	//! どのテストのチェックポイントか。再開時に一致を確認する。
+	std::string		abstract;
+	std::string		caseDescription;
+	//! この runTest() で成功したケースの数(maxCount と比べる数)。
+	size_t			count;
+	size_t			passCount;
+	size_t			skipCount;
+	std::chrono::nanoseconds	elapsed;
+	//! 生成器の状態。生成器が対応していなければ空。
+	bool			hasGeneratorState;
+	std::string		generatorState;
+	Checkpoint()
+	:abstract()
+	,caseDescription()
+	,count()
+	,passCount()
+	,skipCount()
+	,elapsed()
+	,hasGeneratorState(false)
+	,generatorState()
+	{}
+}; // struct Checkpoint
+
+namespace	detail {
+	//! Write the checkpoint through a temporary file, so that a crash while writing keeps the previous one.
+	bool			writeCheckpoint(const std::string &path, const Checkpoint &cp);
+	//! Read the checkpoint. Returns false if it does not exist or is broken.
+	bool			readCheckpoint(const std::string &path, Checkpoint &cp);
+	void			removeCheckpoint(const std::string &path);
+} // namespace detail
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__CHECKPOINT_HPP_
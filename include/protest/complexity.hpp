@@ -0,0 +1,222 @@
+/*!
+ * \file   complexity.hpp
+ * \brief  Empirical check of computational complexity.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__COMPLEXITY_HPP_
+#define	INCLUDED__NU11P0__PROTEST__COMPLEXITY_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+#ifndef	INCLUDED__NU11P0__PROTEST__PERF_CONDITION_HPP_
+#	include <protest/perf_condition.hpp>
+#endif
+
+#include <chrono>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace	nu11p0 {
+namespace	protest {
+
+//! Complexity classes, in increasing order.
+enum class	Complexity {
+	Constant,
+	Logarithmic,
+	Linear,
+	NLogN,
+	Quadratic,
+	Cubic,
+}; // enum class Complexity
+
+//! Name of the complexity class, such as "O(n log n)".
+const char		*complexityName(Complexity c);
+
+//! Result of fitting timings against complexity classes.
+struct	ComplexityFit {
+	Complexity		bestFit;
+	//! 最もよく当てはまったクラスの正規化された残差。
+	double			rms;
+	//! 時間 ≒ intercept + coefficient * g(n) の係数(ナノ秒)。
+	double			coefficient;
+	//! 大きさによらない時間(呼び出しや計測のオーバーヘッド、ナノ秒)。
+	double			intercept;
+	ComplexityFit()
+	:bestFit(Complexity::Constant)
+	,rms()
+	,coefficient()
+	,intercept()
+	{}
+}; // struct ComplexityFit
+
+//! Fit timings against each complexity class and choose the best one.
+/*!
+ * 各クラス g(n) について、重み 1/t^2 の最小二乗法で t ≒ a + b * g(n) を当てはめ、
+ * 相対残差 (t - a - b * g(n)) / t の二乗平均平方根(rms)を求める。
+ * 相対残差で見るので、どの大きさの計測も同じ重みで当てはまりに効く。
+ * 定数項 a が固定のオーバーヘッドを吸収するので、小さな入力で低いクラスに見誤りにくい。
+ * b が負になるクラスは、 b = 0 として扱う。
+ * rms が最小値 minRms の (1 + tolerance) 倍に計測のノイズ分(2%)を足した値以下のクラスのうち、
+ * 最も低いものを選ぶ。差を最小値に対する比で見るので、高いクラスの rms がはっきり小さければそちらを選ぶ。
+ */
+ComplexityFit	fitComplexity(const std::vector<SizeTiming> &series, double tolerance=0.5);
+
+//! Options for ComplexityTest.
+struct	ComplexityOptions {
+	//! 最小の入力の大きさ。
+	size_t			minSize;
+	//! 最大の入力の大きさ。
+	size_t			maxSize;
+	//! 入力の大きさを何倍ずつ大きくするか。
+	double			growth;
+	//! 大きさごとに生成する入力の数。時間はそれらの平均とする。
+	size_t			casesPerSize;
+	//! 入力ごとの計測の設定。中央値を時間とする。
+	PerfOptions		perf;
+	//! fitComplexity() に渡す、最良の rms に対する相対的な許容差。
+	double			tolerance;
+	ComplexityOptions()
+	:minSize(64)
+	,maxSize(64 * 1024)
+	,growth(2.0)
+	,casesPerSize(3)
+	,perf()
+	,tolerance(0.5)
+	{
+		perf.repetitions = 7;
+	}
+}; // struct ComplexityOptions
+
+namespace	detail {
+	template <typename Gen, typename=void>
+	struct	HasGenerate : std::false_type {};
+	template <typename Gen>
+	struct	HasGenerate<Gen, decltype(std::declval<Gen &>().generate(size_t()), void())>
+		: std::true_type
+	{};
+
+	//! Generate an input of the size: by gen.generate(size) (e.g. case_gen::Sized), or gen(size).
+	template <typename Gen>
+	auto			generateSized(Gen &gen, size_t size)
+		-> std::enable_if_t<HasGenerate<Gen>{}, decltype(gen.generate(size))>
+	{
+		return	gen.generate(size);
+	}
+	template <typename Gen>
+	auto			generateSized(Gen &gen, size_t size)
+		-> std::enable_if_t<!HasGenerate<Gen>{}, decltype(gen(size))>
+	{
+		return	gen(size);
+	}
+} // namespace detail
+
+//! Test which measures the complexity of a function over inputs of growing size.
+/*!
+ * 入力の大きさを minSize から maxSize まで growth 倍ずつ大きくしながら関数の時間を計測し、
+ * 計算量のクラスに当てはめる。最もよく当てはまったクラスが宣言された上限より悪ければ失敗する。
+ * 計測した系列と当てはめの結果は TestResult::complexity に設定される。
+ * 失敗した場合の failedCase は計測した最大の入力の大きさ(size_t)になる。
+ *
+ * 使用例:
+ *     protest::ComplexityTest<std::vector<int>>	test("mySort is O(n log n)", mySort, protest::Complexity::NLogN);
+ *     test.runTest("random vector", protest::case_gen::SizedVector<int>(), std::cout);
+ *
+ * 小さな入力では定数項が支配的になるため、 minSize は十分大きくすること。
+ */
+template <typename T>
+class	ComplexityTest {
+	public:
+		using	param_type = T;
+	private:
+		TestResult		m_result;
+		std::function<void(const param_type &)>	m_fun;
+		Complexity		m_bound;
+		ComplexityOptions	m_opts;
+		std::vector<double>	m_samples;
+	public:
+		template <typename F>
+		ComplexityTest(std::string &&a, F &&f, Complexity bound, ComplexityOptions opts=ComplexityOptions())
+		:m_result()
+		,m_fun(detail::measurable<param_type>(std::forward<F>(f)))
+		,m_bound(bound)
+		,m_opts(opts)
+		,m_samples()
+		{
+			m_result.abstract = std::forward<std::string>(a);
+		}
+		void			clearError(void)
+		{
+			m_result.clearError();
+		}
+		void			clearAll(void)
+		{
+			m_result.clearAll();
+		}
+		/*!
+		 * \param gen  Generator of inputs: gen.generate(size) or gen(size) returns an input of the size.
+		 */
+		template <typename Gen>
+		const TestResult	&runTest(std::string &&caseDescription, Gen &&gen, std::ostream &ost=nullOstream())
+		{
+			if(m_result.isTestFailed()) {
+				// 以前のテストのエラー情報がクリアされていない。
+				return	m_result;
+			}
+			m_result.lastCaseDescription = std::forward<std::string>(caseDescription);
+			auto			&report = m_result.complexity;
+			report = ComplexityReport();
+			const auto		startTime = std::chrono::steady_clock::now();
+			const bool		ostreamAvailable = isOstreamAvailable(ost);
+			size_t			size = m_opts.minSize ? m_opts.minSize : 1;
+			while(size <= m_opts.maxSize) {
+				double			total = 0.0;
+				const size_t	cases = m_opts.casesPerSize ? m_opts.casesPerSize : 1;
+				for(size_t i = 0; i < cases; ++i) {
+					const param_type	input = detail::generateSized(gen, size);
+					total += measure(input);
+				}
+				const auto		ns = static_cast<std::chrono::nanoseconds::rep>(total / static_cast<double>(cases));
+				report.series.push_back(SizeTiming{size, std::chrono::nanoseconds(ns)});
+				++m_result.passCount;
+				if(ostreamAvailable) {
+					ost << "  n=" << size << ": " << detail::formatNanoseconds(static_cast<double>(ns)) << '\n';
+				}
+				const auto		next = static_cast<size_t>(static_cast<double>(size) * m_opts.growth);
+				size = (next > size) ? next : (size + 1);
+			}
+			m_result.elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime);
+			const auto		fit = fitComplexity(report.series, m_opts.tolerance);
+			report.bestFit = complexityName(fit.bestFit);
+			report.rms = fit.rms;
+			if(fit.bestFit > m_bound) {
+				m_result.failedCase = report.series.empty() ? size_t() : report.series.back().size;
+				m_result.reason.emplace("best fit " + report.bestFit + " is worse than the bound " + complexityName(m_bound));
+			}
+			return	m_result;
+		}
+	private:
+		//! Median time of a call in nanoseconds.
+		double			measure(const param_type &input)
+		{
+			const auto		&perf = m_opts.perf;
+			const size_t	iterations = detail::calibrate(m_fun, input, perf);
+			for(size_t i = 0; i < perf.warmup; ++i) {
+				detail::sample(m_fun, input, iterations);
+			}
+			m_samples.clear();
+			for(size_t i = 0; i < perf.repetitions; ++i) {
+				m_samples.push_back(detail::sample(m_fun, input, iterations));
+			}
+			return	detail::summarizeSamples(m_samples, perf).median;
+		}
+}; // class ComplexityTest
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__COMPLEXITY_HPP_
@@ -16,7 +16,7 @@
 namespace	nu11p0 {
 namespace	protest {
 
-CheckResult		AssertResult(bool condition, std::string &&reason)
+inline CheckResult	AssertResult(bool condition, std::string &&reason)
 {
 	CheckResult		ret;
 	if(!condition) {
@@ -25,6 +25,16 @@ CheckResult		AssertResult(bool condition, std::string &&reason)
 	return	ret;
 }
 
+// 文字列リテラルを渡された場合、成功したケースでは std::string を構築しない。
+inline CheckResult	AssertResult(bool condition, const char *reason)
+{
+	CheckResult		ret;
+	if(!condition) {
+		ret.reason.emplace(reason);
+	}
+	return	ret;
+}
+
 template <typename Param>
 class	Idempotent {
 	public:
@@ -0,0 +1,420 @@
+/*!
+ * \file   equivalent.hpp
+ * \brief  Differential conditions which compare an implementation with its reference.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__EQUIVALENT_HPP_
+#define	INCLUDED__NU11P0__PROTEST__EQUIVALENT_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace	nu11p0 {
+namespace	protest {
+
+namespace	detail {
+
+	//! Bit pattern types of float and double.
+	template <typename T>
+	struct	FloatBits;
+	template <>
+	struct	FloatBits<float> {
+		using	bits_type = uint32_t;
+		using	signed_type = int32_t;
+		static constexpr bits_type	sign = 0x80000000u;
+		static constexpr bits_type	infinity = 0x7f800000u;
+	};
+	template <>
+	struct	FloatBits<double> {
+		using	bits_type = uint64_t;
+		using	signed_type = int64_t;
+		static constexpr bits_type	sign = 0x8000000000000000u;
+		static constexpr bits_type	infinity = 0x7ff0000000000000u;
+	};
+
+	template <typename T>
+	typename FloatBits<T>::bits_type	floatBits(const T &x)
+	{
+		typename FloatBits<T>::bits_type	bits;
+		std::memcpy(&bits, &x, sizeof(bits));
+		return	bits;
+	}
+
+	//! True (1) if the bit pattern is NaN.
+	template <typename T>
+	typename FloatBits<T>::bits_type	isNanBits(typename FloatBits<T>::bits_type bits)
+	{
+		return	(bits & ~FloatBits<T>::sign) > FloatBits<T>::infinity;
+	}
+
+	//! Map the bit pattern of a floating point number to a signed integer with the same order.
+	/*!
+	 * 正の数はビット列そのまま、負の数は符号と絶対値を反転する。 +0 と -0 はどちらも 0 になる。
+	 * 浮動小数点数の演算も分岐も使わないので、配列に対するループはベクトル化される。
+	 */
+	template <typename T>
+	typename FloatBits<T>::signed_type	orderedBits(typename FloatBits<T>::bits_type bits)
+	{
+		using	bits_type = typename FloatBits<T>::bits_type;
+		using	signed_type = typename FloatBits<T>::signed_type;
+		// 負なら全ビット1、正なら0。
+		const bits_type	mask = static_cast<bits_type>(static_cast<signed_type>(bits) >> (sizeof(bits_type) * CHAR_BIT - 1));
+		// 負の数は sign - bits (符号無しの演算なのでオーバーフローしない)。
+		return	static_cast<signed_type>(((bits ^ mask) - mask) + (mask & FloatBits<T>::sign));
+	}
+
+	//! Absolute difference of two ordered bit patterns.
+	/*!
+	 * 差は要素と同じ幅の符号無し整数に収まる。
+	 */
+	template <typename I>
+	std::make_unsigned_t<I>	orderedDistance(I a, I b)
+	{
+		using	U = std::make_unsigned_t<I>;
+		return	(a < b) ? static_cast<U>(static_cast<U>(b) - static_cast<U>(a))
+				: static_cast<U>(static_cast<U>(a) - static_cast<U>(b));
+	}
+
+	template <typename T>
+	using	HasUlps = std::integral_constant<bool,
+			std::is_same<T, float>::value || std::is_same<T, double>::value>;
+
+	//! Check whether type T is printable with std::ostream.
+	template <typename T, typename =void>
+	struct	OstreamPrintable : public std::false_type {};
+	template <typename T>
+	struct	OstreamPrintable<
+			T,
+			std::enable_if_t<decltype(
+				std::declval<std::ostream &>() << std::declval<const T &>(),
+				std::true_type{}
+			)::value>
+		>
+		: public std::true_type
+	{};
+
+	//! Describe a value for failure reasons.
+	template <typename T>
+	auto			describeValue(const T &val)
+		-> std::enable_if_t<std::is_arithmetic<T>::value, std::string>
+	{
+		std::ostringstream	ost;
+		// 浮動小数点数は元の値に戻せる桁数で出す。1ULPの違いも見えるように。
+		ost.precision(std::numeric_limits<T>::max_digits10);
+		// char 系の型は数値として出す。
+		ost << +val;
+		return	ost.str();
+	}
+	template <typename T>
+	auto			describeValue(const T &val)
+		-> std::enable_if_t<!std::is_arithmetic<T>::value && OstreamPrintable<T>::value, std::string>
+	{
+		std::ostringstream	ost;
+		ost << val;
+		return	ost.str();
+	}
+	template <typename T>
+	auto			describeValue(const T &)
+		-> std::enable_if_t<!OstreamPrintable<T>::value, std::string>
+	{
+		return	"(unprintable)";
+	}
+
+} // namespace detail
+
+//! Distance between two floating point numbers in units in the last place.
+/*!
+ * 隣り合う表現可能な値の距離が1。 +0 と -0 の距離は0。
+ * 片方だけが NaN なら UINT64_MAX 、両方 NaN なら0とする。
+ */
+template <typename T>
+auto			ulpDistance(T a, T b)
+	-> std::enable_if_t<detail::HasUlps<T>::value, uint64_t>
+{
+	const auto		bitsA = detail::floatBits(a);
+	const auto		bitsB = detail::floatBits(b);
+	const bool		nanA = detail::isNanBits<T>(bitsA);
+	const bool		nanB = detail::isNanBits<T>(bitsB);
+	if(nanA || nanB) {
+		return	(nanA && nanB) ? 0 : UINT64_MAX;
+	}
+	return	detail::orderedDistance(detail::orderedBits<T>(bitsA), detail::orderedBits<T>(bitsB));
+}
+
+namespace	detail {
+
+	//! " (ULP distance: N)" for float and double, empty for other types.
+	template <typename T>
+	auto			describeUlps(T fast, T reference)
+		-> std::enable_if_t<HasUlps<T>::value, std::string>
+	{
+		const uint64_t	dist = ulpDistance(fast, reference);
+		return	" (ULP distance: " + ((dist == UINT64_MAX) ? std::string("NaN") : std::to_string(dist)) + ")";
+	}
+	template <typename T>
+	auto			describeUlps(const T &, const T &)
+		-> std::enable_if_t<!HasUlps<T>::value, std::string>
+	{
+		return	std::string();
+	}
+
+} // namespace detail
+
+//! Comparators of outputs for Equivalent and BatchEquivalent.
+/*!
+ * 比較器は `bool operator()(const R &fast, const R &reference)' を持つ関数オブジェクト。
+ * Exact と Ulp は、 BatchEquivalent でベクトル化された比較に置き換えられる。
+ */
+namespace	compare {
+
+	//! Outputs must be equal.
+	/*!
+	 * 浮動小数点数は値が等しければよい(+0 と -0 は等しい)。両方 NaN の場合も等しいとみなす。
+	 */
+	struct	Exact {
+		template <typename T>
+		auto			operator()(const T &fast, const T &reference) const
+			-> std::enable_if_t<!std::is_floating_point<T>::value, bool>
+		{
+			return	fast == reference;
+		}
+		template <typename T>
+		auto			operator()(T fast, T reference) const
+			-> std::enable_if_t<std::is_floating_point<T>::value, bool>
+		{
+			// -Wfloat-equal を避け、 NaN 同士も等しいとするため、 < と isnan で比べる。
+			return	!(fast < reference) && !(reference < fast) && (std::isnan(fast) == std::isnan(reference));
+		}
+	}; // struct Exact
+
+	//! Floating point outputs may differ by at most maxUlps units in the last place.
+	struct	Ulp {
+		uint64_t		maxUlps;
+		explicit Ulp(uint64_t maxUlps_)
+		:maxUlps(maxUlps_)
+		{}
+		template <typename T>
+		bool			operator()(T fast, T reference) const {
+			return	ulpDistance(fast, reference) <= maxUlps;
+		}
+	}; // struct Ulp
+
+} // namespace compare
+
+//! Check that the function gives the same output as its reference implementation.
+/*!
+ * 最適化した実装(fast)と素朴な参照実装(reference)に同じ引数を与え、出力を Compare で比べる。
+ * 失敗時の理由には両方の出力と、浮動小数点数なら ULP 距離を含める。
+ *
+ * 比較器にラムダ式等を使う場合は EquivalentBy を使う。
+ */
+template <typename Param, typename Result, typename Compare=compare::Exact>
+class	Equivalent {
+	public:
+		using	param_type = Param;
+		using	result_type = Result;
+	private:
+		std::function<result_type(const param_type &)>	m_fast;
+		std::function<result_type(const param_type &)>	m_reference;
+		Compare			m_compare;
+	public:
+		template <typename F, typename G>
+		Equivalent(F &&fast, G &&reference, Compare compare=Compare())
+		:m_fast(std::forward<F>(fast))
+		,m_reference(std::forward<G>(reference))
+		,m_compare(std::move(compare))
+		{}
+		~Equivalent() = default;
+		Equivalent(const Equivalent &) = default;
+		Equivalent(Equivalent &&) = default;
+		CheckResult		operator()(const param_type &arg)
+		{
+			CheckResult		ret;
+			const result_type	fast = m_fast(arg);
+			const result_type	reference = m_reference(arg);
+			if(!m_compare(fast, reference)) {
+				ret.reason.emplace("outputs differ: fast=" + detail::describeValue(fast)
+						+ ", reference=" + detail::describeValue(reference)
+						+ detail::describeUlps(fast, reference));
+			}
+			return	ret;
+		}
+}; // class Equivalent
+
+//! Equivalent with a custom comparator such as a lambda.
+template <typename Param, typename Result>
+using	EquivalentBy = Equivalent<Param, Result, std::function<bool(const Result &, const Result &)>>;
+
+namespace	detail {
+
+	//! 一度に比較する要素数。不一致はブロック単位で検出し、見つかったブロックの中だけ順に探す。
+	constexpr size_t	mismatchBlock = 256;
+
+	//! Index of the first element which does not satisfy the comparator, or n if none.
+	template <typename T, typename Compare>
+	size_t			firstMismatch(const T *fast, const T *reference, size_t n, Compare &compare)
+	{
+		for(size_t i = 0; i < n; ++i) {
+			if(!compare(fast[i], reference[i])) {
+				return	i;
+			}
+		}
+		return	n;
+	}
+
+	//! Scan blocks with a branch-free predicate, then locate the element in the first failing block.
+	/*!
+	 * 述語は不一致なら1を Acc 型で返す。 Acc を要素と同じ幅にしておくと、
+	 * ブロック内のループは論理和の縮約としてベクトル化される。
+	 * (64ビットの要素は、64ビット整数の比較を持つ命令セット、例えば AVX2 でベクトル化される。)
+	 */
+	template <typename Acc, typename Bad>
+	size_t			firstMismatchBlocked(size_t n, Bad bad)
+	{
+		const auto		find = [&bad](size_t begin, size_t end) {
+				for(size_t i = begin; i < end; ++i) {
+					if(bad(i)) {
+						return	i;
+					}
+				}
+				return	end;
+			};
+		size_t			begin = 0;
+		// 回数が定数のループにしておくと、 -O2 (GCC の very-cheap コストモデル)でもベクトル化される。
+		for(; begin + mismatchBlock <= n; begin += mismatchBlock) {
+			Acc				any = 0;
+			for(size_t i = 0; i < mismatchBlock; ++i) {
+				any |= bad(begin + i);
+			}
+			if(any) {
+				return	find(begin, begin + mismatchBlock);
+			}
+		}
+		return	find(begin, n);
+	}
+
+	//! Unsigned integer as wide as T.
+	template <typename T>
+	using	SameWidthUnsigned = std::conditional_t<(sizeof(T) <= 1), uint8_t,
+			std::conditional_t<(sizeof(T) <= 2), uint16_t,
+			std::conditional_t<(sizeof(T) <= 4), uint32_t, uint64_t>>>;
+
+	template <typename T>
+	auto			firstMismatch(const T *fast, const T *reference, size_t n, compare::Exact &)
+		-> std::enable_if_t<std::is_integral<T>::value, size_t>
+	{
+		using	Acc = SameWidthUnsigned<T>;
+		return	firstMismatchBlocked<Acc>(n, [fast, reference](size_t i) {
+				return	static_cast<Acc>(fast[i] != reference[i]);
+			});
+	}
+
+	template <typename T>
+	auto			firstMismatch(const T *fast, const T *reference, size_t n, compare::Exact &)
+		-> std::enable_if_t<HasUlps<T>::value, size_t>
+	{
+		using	Acc = typename FloatBits<T>::bits_type;
+		return	firstMismatchBlocked<Acc>(n, [fast, reference](size_t i) {
+				const T			a = fast[i];
+				const T			b = reference[i];
+				// std::isnan は関数呼び出しになりうるので、順序付けできないかどうかの比較で NaN を判定する。
+				return	static_cast<Acc>((a < b) | (b < a) | (std::isunordered(a, a) ^ std::isunordered(b, b)));
+			});
+	}
+
+	template <typename T>
+	auto			firstMismatch(const T *fast, const T *reference, size_t n, compare::Ulp &compare)
+		-> std::enable_if_t<HasUlps<T>::value, size_t>
+	{
+		using	Acc = typename FloatBits<T>::bits_type;
+		// 距離は要素と同じ幅で計算する(float の距離は32ビットに収まる)ので、許容値も丸めておく。
+		const Acc		maxUlps = static_cast<Acc>(std::min<uint64_t>(compare.maxUlps, std::numeric_limits<Acc>::max()));
+		return	firstMismatchBlocked<Acc>(n, [fast, reference, maxUlps](size_t i) {
+				// 浮動小数点数として読まず、ビット列だけで判定する。
+				const Acc		a = floatBits(fast[i]);
+				const Acc		b = floatBits(reference[i]);
+				const Acc		nanA = isNanBits<T>(a);
+				const Acc		nanB = isNanBits<T>(b);
+				const Acc		far = orderedDistance(orderedBits<T>(a), orderedBits<T>(b)) > maxUlps;
+				return	static_cast<Acc>((nanA ^ nanB) | (~nanA & ~nanB & far & 1u));
+			});
+	}
+
+} // namespace detail
+
+//! Check that a batch kernel gives the same outputs as its reference kernel.
+/*!
+ * 生成されたケースの配列(std::vector<T>)を一つのテストケースとし、
+ * 両方のカーネル `void(const T *in, Result *out, size_t n)' に通して出力の配列を比べる。
+ * 要素ごとに関数を呼ぶ Equivalent と違い、カーネルの呼び出しと比較の費用が配列全体で償却される。
+ * 出力の配列は次のケースで再利用される。
+ *
+ * Compare が compare::Exact か compare::Ulp の場合、比較はベクトル化されたループで行われる。
+ * 失敗時の理由には最初に食い違った要素の位置、入力、両方の出力、 ULP 距離を含める。
+ */
+template <typename T, typename Result, typename Compare=compare::Exact>
+class	BatchEquivalent {
+	public:
+		using	param_type = std::vector<T>;
+		using	result_type = Result;
+		using	kernel_type = std::function<void(const T *, result_type *, size_t)>;
+	private:
+		kernel_type		m_fast;
+		kernel_type		m_reference;
+		Compare			m_compare;
+		std::vector<result_type>	m_fastOut;
+		std::vector<result_type>	m_referenceOut;
+	public:
+		template <typename F, typename G>
+		BatchEquivalent(F &&fast, G &&reference, Compare compare=Compare())
+		:m_fast(std::forward<F>(fast))
+		,m_reference(std::forward<G>(reference))
+		,m_compare(std::move(compare))
+		,m_fastOut()
+		,m_referenceOut()
+		{}
+		~BatchEquivalent() = default;
+		BatchEquivalent(const BatchEquivalent &) = default;
+		BatchEquivalent(BatchEquivalent &&) = default;
+		CheckResult		operator()(const param_type &batch)
+		{
+			CheckResult		ret;
+			const size_t	n = batch.size();
+			m_fastOut.resize(n);
+			m_referenceOut.resize(n);
+			m_fast(batch.data(), m_fastOut.data(), n);
+			m_reference(batch.data(), m_referenceOut.data(), n);
+			const size_t	i = detail::firstMismatch(m_fastOut.data(), m_referenceOut.data(), n, m_compare);
+			if(i < n) {
+				ret.reason.emplace("outputs differ at index " + std::to_string(i) + " of " + std::to_string(n)
+						+ ": input=" + detail::describeValue(batch[i])
+						+ ", fast=" + detail::describeValue(m_fastOut[i])
+						+ ", reference=" + detail::describeValue(m_referenceOut[i])
+						+ detail::describeUlps(m_fastOut[i], m_referenceOut[i]));
+			}
+			return	ret;
+		}
+}; // class BatchEquivalent
+
+//! BatchEquivalent with a custom comparator such as a lambda.
+template <typename T, typename Result>
+using	BatchEquivalentBy = BatchEquivalent<T, Result, std::function<bool(const Result &, const Result &)>>;
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__EQUIVALENT_HPP_
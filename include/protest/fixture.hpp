@@ -0,0 +1,238 @@
+/*!
+ * \file   fixture.hpp
+ * \brief  Pools of expensive fixtures shared by tests and worker threads.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__FIXTURE_HPP_
+#define	INCLUDED__NU11P0__PROTEST__FIXTURE_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace	nu11p0 {
+namespace	protest {
+
+//! Pool of fixtures, such as a loaded index or a warmed cache.
+/*!
+ * acquire() は空いているフィクスチャを貸し出し、無ければ factory で作る。
+ * 返されたフィクスチャは捨てずに次の acquire() で再利用されるので、
+ * factory が呼ばれる回数は同時にフィクスチャを使うテストの数(普通は --jobs のワーカー数)で済む。
+ * 一つのフィクスチャが同時に二つのスレッドに貸し出されることはない。
+ *
+ * reset はケースごと(withFixture() の性質を呼ぶ前)に呼ばれ、前のケースの状態を消す。
+ *
+ * プールは貸し出した全ての Lease より長く生存しなければならない。
+ * 普通は、テストのファイルの静的変数にする。
+ */
+template <typename Fixture>
+class	FixturePool {
+	public:
+		using	fixture_type = Fixture;
+		using	factory_type = std::function<std::unique_ptr<fixture_type>()>;
+		using	reset_type = std::function<void(fixture_type &)>;
+		//! Fixture lent from the pool. Returned to the pool on destruction.
+		class	Lease {
+			private:
+				FixturePool		*m_pool;
+				std::unique_ptr<fixture_type>	m_fixture;
+			public:
+				Lease()
+				:m_pool(nullptr)
+				,m_fixture()
+				{}
+				Lease(FixturePool *pool, std::unique_ptr<fixture_type> &&fixture)
+				:m_pool(pool)
+				,m_fixture(std::move(fixture))
+				{}
+				Lease(Lease &&other)
+				:m_pool(std::exchange(other.m_pool, nullptr))
+				,m_fixture(std::move(other.m_fixture))
+				{}
+				Lease			&operator=(Lease &&other)
+				{
+					if(this != &other) {
+						release();
+						m_pool = std::exchange(other.m_pool, nullptr);
+						m_fixture = std::move(other.m_fixture);
+					}
+					return	*this;
+				}
+				Lease(const Lease &) = delete;
+				Lease			&operator=(const Lease &) = delete;
+				~Lease()
+				{
+					release();
+				}
+				explicit		operator bool() const
+				{
+					return	static_cast<bool>(m_fixture);
+				}
+				fixture_type	&operator*() const
+				{
+					return	*m_fixture;
+				}
+				fixture_type	*operator->() const
+				{
+					return	m_fixture.get();
+				}
+				//! Return the fixture to the pool now.
+				void			release(void)
+				{
+					if(m_pool && m_fixture) {
+						m_pool->giveBack(std::move(m_fixture));
+					}
+					m_pool = nullptr;
+				}
+		}; // class Lease
+	private:
+		factory_type	m_factory;
+		reset_type		m_reset;
+		std::mutex		m_mutex;
+		std::vector<std::unique_ptr<fixture_type>>	m_free;
+		size_t			m_created;
+		void			giveBack(std::unique_ptr<fixture_type> &&fixture)
+		{
+			std::lock_guard<std::mutex>	lock(m_mutex);
+			m_free.push_back(std::move(fixture));
+		}
+	public:
+		template <typename F>
+		explicit FixturePool(F &&factory)
+		:FixturePool(std::forward<F>(factory), reset_type())
+		{}
+		template <typename F, typename R>
+		FixturePool(F &&factory, R &&reset)
+		:m_factory(std::forward<F>(factory))
+		,m_reset(std::forward<R>(reset))
+		,m_mutex()
+		,m_free()
+		,m_created()
+		{}
+		FixturePool(const FixturePool &) = delete;
+		FixturePool		&operator=(const FixturePool &) = delete;
+		//! Lend a free fixture, or create one.
+		/*!
+		 * factory はロックの外で呼ぶので、重い初期化を並行して行える。
+		 */
+		Lease			acquire(void)
+		{
+			{
+				std::lock_guard<std::mutex>	lock(m_mutex);
+				if(!m_free.empty()) {
+					auto			fixture = std::move(m_free.back());
+					m_free.pop_back();
+					return	Lease(this, std::move(fixture));
+				}
+				++m_created;
+			}
+			return	Lease(this, m_factory());
+		}
+		//! Call the reset hook, if any.
+		void			reset(fixture_type &fixture) const
+		{
+			if(m_reset) {
+				m_reset(fixture);
+			}
+		}
+		//! Number of fixtures created by the factory.
+		size_t			created(void)
+		{
+			std::lock_guard<std::mutex>	lock(m_mutex);
+			return	m_created;
+		}
+		//! Number of fixtures waiting in the pool.
+		size_t			available(void)
+		{
+			std::lock_guard<std::mutex>	lock(m_mutex);
+			return	m_free.size();
+		}
+		//! Destroy fixtures waiting in the pool. Lent fixtures are kept.
+		void			clear(void)
+		{
+			std::lock_guard<std::mutex>	lock(m_mutex);
+			m_free.clear();
+		}
+}; // class FixturePool
+
+namespace	detail {
+
+	//! Lease held by a property. Acquired at the first case and kept until the property is destroyed.
+	/*!
+	 * 複製はフィクスチャを共有せず、最初に使われたときに自分のフィクスチャを借りる。
+	 * SimpleTest はタイムアウトを検査するために性質を複製し、タイムアウトしたら複製を放棄したスレッドに残すので、
+	 * 共有すると次のケースが放棄されたケースと同じフィクスチャを使ってしまう。
+	 */
+	template <typename Fixture>
+	class	FixtureBinding {
+		private:
+			FixturePool<Fixture>	*m_pool;
+			typename FixturePool<Fixture>::Lease	m_lease;
+		public:
+			explicit FixtureBinding(FixturePool<Fixture> &pool)
+			:m_pool(&pool)
+			,m_lease()
+			{}
+			FixtureBinding(const FixtureBinding &other)
+			:m_pool(other.m_pool)
+			,m_lease()
+			{}
+			FixtureBinding(FixtureBinding &&other) = default;
+			FixtureBinding	&operator=(const FixtureBinding &) = delete;
+			FixtureBinding	&operator=(FixtureBinding &&) = delete;
+			//! Fixture reset for the next case.
+			Fixture			&get(void)
+			{
+				if(!m_lease) {
+					m_lease = m_pool->acquire();
+				}
+				m_pool->reset(*m_lease);
+				return	*m_lease;
+			}
+	}; // class FixtureBinding
+
+} // namespace detail
+
+//! Property which receives a fixture from the pool: `CheckResult(Fixture &, const Param &)'.
+/*!
+ * 最初のケースでプールからフィクスチャを借り、性質が破棄される(SimpleTest が破棄される)まで使い続ける。
+ * 各ケースの前にプールの reset が呼ばれる。
+ * timeout() でケースがタイムアウトした場合、そのフィクスチャは放棄されたケースが終わるまで返されず、
+ * 次のケースは別のフィクスチャを借りる。
+ */
+template <typename Param, typename Fixture, typename F>
+auto			withFixture(FixturePool<Fixture> &pool, F &&f)
+	-> std::enable_if_t<!is_callable<std::decay_t<F> &, Fixture &, Span<const Param>, Span<uint8_t>>::value,
+			std::function<CheckResult(const Param &)>>
+{
+	return	[binding=detail::FixtureBinding<Fixture>(pool), fun=std::forward<F>(f)](const Param &arg) mutable {
+			return	fun(binding.get(), arg);
+		};
+}
+
+//! Batch property which receives a fixture: `void(Fixture &, Span<const Param>, Span<uint8_t>)'.
+/*!
+ * reset はバッチごとに呼ばれる。
+ */
+template <typename Param, typename Fixture, typename F>
+auto			withFixture(FixturePool<Fixture> &pool, F &&f)
+	-> std::enable_if_t<is_callable<std::decay_t<F> &, Fixture &, Span<const Param>, Span<uint8_t>>::value,
+			std::function<void(Span<const Param>, Span<uint8_t>)>>
+{
+	return	[binding=detail::FixtureBinding<Fixture>(pool), fun=std::forward<F>(f)](Span<const Param> cases, Span<uint8_t> failed) mutable {
+			fun(binding.get(), cases, failed);
+		};
+}
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__FIXTURE_HPP_
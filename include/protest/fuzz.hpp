@@ -0,0 +1,315 @@
+/*!
+ * \file   fuzz.hpp
+ * \brief  Coverage-guided test case generator.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__FUZZ_HPP_
+#define	INCLUDED__NU11P0__PROTEST__FUZZ_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace	nu11p0 {
+namespace	protest {
+
+/*!
+ * Clang の -fsanitize-coverage=trace-pc-guard によるカバレッジ情報へのアクセス。
+ *
+ * コールバック(__sanitizer_cov_trace_pc_guard など)は libprotest で定義されているため、
+ * テスト対象とテストのソースを -fsanitize-coverage=trace-pc-guard 付きでコンパイルし、
+ * libprotest をリンクするだけで利用できる。
+ * 計装されたコードが存在しない場合、guardCount() は0を返し、何も記録されない。
+ */
+namespace	coverage {
+
+//! Number of instrumented edges (guards) registered so far.
+size_t			guardCount(void);
+//! Number of distinct (edge, hit count bucket) features observed so far.
+size_t			featureCount(void);
+//! Discard hit counts recorded since the last call.
+void			clearCounters(void);
+//! Merge hit counts into the feature set, and return the number of new features.
+/*!
+ * 記録済みのヒット数はクリアされる。
+ */
+size_t			mergeCounters(void);
+
+//! Load all regular files in the directory as corpus entries.
+/*!
+ * ディレクトリが存在しなければ何もしない。
+ */
+std::vector<std::string>	loadCorpus(const std::string &dir);
+//! Store the data to the directory, with the name derived from its hash.
+/*!
+ * ディレクトリが存在しなければ作成する。
+ * \return true if succeeded.
+ */
+bool			storeCorpusEntry(const std::string &dir, const std::string &data);
+
+} // namespace coverage
+
+namespace	case_gen {
+
+//! Conversion between test cases and byte sequences, used by Fuzz.
+/*!
+ * trivially copyableな型、std::basic_string、trivially copyableな要素のstd::vectorについて用意してある。
+ * その他の型をFuzzで使いたい場合は、特殊化すること。
+ */
+template <typename T, typename=void>
+struct	FuzzCodec;
+
+template <typename T>
+struct	FuzzCodec<T, std::enable_if_t<std::is_trivially_copyable<T>::value>> {
+	//! Byte length of the value. 0 if variable.
+	static constexpr size_t	fixedSize = sizeof(T);
+	static void		encode(const T &val, std::string &bytes)
+	{
+		bytes.assign(reinterpret_cast<const char *>(&val), sizeof(T));
+	}
+	static T		decode(const std::string &bytes)
+	{
+		T				val;
+		// 長さが足りない場合はゼロで埋める。
+		std::memset(&val, 0, sizeof(T));
+		std::memcpy(&val, bytes.data(), std::min(bytes.size(), sizeof(T)));
+		return	val;
+	}
+}; // struct FuzzCodec
+
+template <typename Char, typename Traits, typename Alloc>
+struct	FuzzCodec<std::basic_string<Char, Traits, Alloc>> {
+	using	value_type = std::basic_string<Char, Traits, Alloc>;
+	static constexpr size_t	fixedSize = 0;
+	static void		encode(const value_type &val, std::string &bytes)
+	{
+		bytes.assign(reinterpret_cast<const char *>(val.data()), val.size() * sizeof(Char));
+	}
+	static value_type	decode(const std::string &bytes)
+	{
+		value_type		val(bytes.size() / sizeof(Char), Char());
+		if(!val.empty()) {
+			std::memcpy(&val[0], bytes.data(), val.size() * sizeof(Char));
+		}
+		return	val;
+	}
+}; // struct FuzzCodec
+
+template <typename E, typename Alloc>
+struct	FuzzCodec<std::vector<E, Alloc>, std::enable_if_t<std::is_trivially_copyable<E>::value>> {
+	using	value_type = std::vector<E, Alloc>;
+	static constexpr size_t	fixedSize = 0;
+	static void		encode(const value_type &val, std::string &bytes)
+	{
+		bytes.assign(reinterpret_cast<const char *>(val.data()), val.size() * sizeof(E));
+	}
+	static value_type	decode(const std::string &bytes)
+	{
+		value_type		val(bytes.size() / sizeof(E));
+		// 空の vector の data() は nullptr でありうるので、長さ0でも memcpy に渡さない。
+		if(!val.empty()) {
+			std::memcpy(val.data(), bytes.data(), val.size() * sizeof(E));
+		}
+		return	val;
+	}
+}; // struct FuzzCodec
+
+//! Coverage-guided mutational test case generator.
+/*!
+ * 直前に生成したテストケースで新しいカバレッジ(エッジとヒット数の組)が得られていれば、
+ * そのケースをコーパスに追加し、以降はコーパス中のケースを変異させて次のケースを作る。
+ * 判定は次のケースを要求されたときに行うので、runTest() からは普通の生成器として使える。
+ *
+ * コーパスディレクトリを指定した場合、生成開始時にディレクトリ内のファイルを初期コーパスとして読み込み、
+ * 新たに見つかった興味深いケースをディレクトリに書き込む。
+ *
+ * カバレッジ計装のないビルドでは、コーパス(と初期シード)を変異させるだけの生成器として動作する。
+ */
+template <typename T, typename Codec=FuzzCodec<T>>
+class	Fuzz {
+	public:
+		using	value_type = T;
+	private:
+		std::vector<std::string>	m_corpus;
+		//! コーパスのうち、まだそのまま実行していないものの位置。
+		size_t			m_pendingSeeds;
+		std::string		m_corpusDir;
+		std::string		m_last;
+		bool			m_hasLast;
+		//! m_last がコーパスのケースをそのまま実行したものか。
+		bool			m_lastIsSeed;
+		size_t			m_maxLength;
+		std::mt19937_64	m_engine;
+	public:
+		//! Fuzz without persistent corpus.
+		Fuzz()
+		:Fuzz(std::string())
+		{}
+		/*!
+		 * \param corpusDir  Directory for persistent corpus. Empty to disable.
+		 * \param maxLength  Maximum byte length of variable-length cases.
+		 */
+		explicit		Fuzz(const std::string &corpusDir, size_t maxLength=4096, uint64_t seed=std::random_device()())
+		:m_corpus()
+		,m_pendingSeeds()
+		,m_corpusDir(corpusDir)
+		,m_last()
+		,m_hasLast(false)
+		,m_lastIsSeed(false)
+		,m_maxLength(Codec::fixedSize ? Codec::fixedSize : maxLength)
+		,m_engine(seed)
+		{
+			if(!m_corpusDir.empty()) {
+				m_corpus = coverage::loadCorpus(m_corpusDir);
+			}
+		}
+		~Fuzz() = default;
+		Fuzz(const Fuzz &) = default;
+		Fuzz(Fuzz &&) = default;
+		//! Add an initial input. Seeds are generated as is before mutated ones.
+		void			addSeed(const value_type &val)
+		{
+			std::string		bytes;
+			Codec::encode(val, bytes);
+			m_corpus.push_back(std::move(bytes));
+		}
+		//! Save the case to the corpus directory (e.g. a failed case to reproduce later).
+		bool			store(const value_type &val) const
+		{
+			std::string		bytes;
+			Codec::encode(val, bytes);
+			return	!m_corpusDir.empty() && coverage::storeCorpusEntry(m_corpusDir, bytes);
+		}
+		size_t			corpusSize(void) const
+		{
+			return	m_corpus.size();
+		}
+		ns_optional::optional<value_type>	operator()(void)
+		{
+			if(m_hasLast && coverage::mergeCounters()) {
+				if(!m_corpusDir.empty()) {
+					coverage::storeCorpusEntry(m_corpusDir, m_last);
+				}
+				// コーパスのケースは既に入っているので、二重に加えない。
+				if(!m_lastIsSeed) {
+					m_corpus.push_back(m_last);
+				}
+			}
+			m_lastIsSeed = (m_pendingSeeds < m_corpus.size());
+			if(m_lastIsSeed) {
+				m_last = m_corpus[m_pendingSeeds++];
+			} else if(m_corpus.empty()) {
+				m_last.resize(Codec::fixedSize ? Codec::fixedSize : uniform(std::min<size_t>(m_maxLength, 8)+1));
+				for(auto &c : m_last) {
+					c = static_cast<char>(m_engine());
+				}
+			} else {
+				m_last = m_corpus[uniform(m_corpus.size())];
+				for(size_t n = 1 + uniform(4); n; --n) {
+					mutate(m_last);
+				}
+			}
+			m_hasLast = true;
+			ns_optional::optional<value_type>	ret(Codec::decode(m_last));
+			// 生成器自身の実行で得られたカバレッジは捨てる。
+			coverage::clearCounters();
+			return	ret;
+		}
+	private:
+		size_t			uniform(size_t n)
+		{
+			return	n ? static_cast<size_t>(m_engine() % n) : 0;
+		}
+		void			mutate(std::string &bytes)
+		{
+			static const unsigned char	interesting[] = {0x00, 0x01, 0x7f, 0x80, 0xff, 0x10, 0x20, 0x40};
+			const bool		resizable = !Codec::fixedSize;
+			if(bytes.empty()) {
+				if(resizable && m_maxLength) {
+					bytes.push_back(static_cast<char>(m_engine()));
+				}
+				return;
+			}
+			switch(uniform(resizable ? 8 : 5)) {
+				case 0:
+					// bit flip
+					bytes[uniform(bytes.size())] ^= static_cast<char>(1u << uniform(8));
+					break;
+				case 1:
+					// random byte
+					bytes[uniform(bytes.size())] = static_cast<char>(m_engine());
+					break;
+				case 2:
+					// interesting byte
+					bytes[uniform(bytes.size())] = static_cast<char>(interesting[uniform(sizeof(interesting))]);
+					break;
+				case 3:
+					// small arithmetic
+					bytes[uniform(bytes.size())] += static_cast<char>(static_cast<int>(uniform(33)) - 16);
+					break;
+				case 4:
+					{
+						// copy a chunk within the case
+						size_t			len = 1 + uniform(bytes.size());
+						size_t			from = uniform(bytes.size() - len + 1);
+						size_t			to = uniform(bytes.size() - len + 1);
+						std::memmove(&bytes[to], &bytes[from], len);
+					}
+					break;
+				case 5:
+					// insert random bytes
+					if(bytes.size() < m_maxLength) {
+						size_t			len = 1 + uniform(std::min<size_t>(m_maxLength - bytes.size(), 16));
+						std::string		ins(len, '\0');
+						for(auto &c : ins) {
+							c = static_cast<char>(m_engine());
+						}
+						bytes.insert(uniform(bytes.size()+1), ins);
+					}
+					break;
+				case 6:
+					{
+						// erase a range
+						size_t			len = 1 + uniform(bytes.size());
+						bytes.erase(uniform(bytes.size() - len + 1), len);
+					}
+					break;
+				case 7:
+					{
+						// crossover with another corpus entry
+						const std::string	&other = m_corpus[uniform(m_corpus.size())];
+						if(!other.empty()) {
+							size_t			pos = uniform(bytes.size());
+							size_t			from = uniform(other.size());
+							bytes.resize(pos);
+							bytes.append(other, from, m_maxLength - pos);
+						}
+					}
+					break;
+				default:
+					break;
+			}
+		}
+}; // class Fuzz
+
+} // namespace case_gen
+
+namespace	generic {
+
+template <typename T>
+using	Fuzz = case_gen::Fuzz<T>;
+
+} // namespace generic
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__FUZZ_HPP_
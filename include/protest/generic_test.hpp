@@ -16,8 +16,17 @@
 #ifndef	INCLUDED__NU11P0__PROTEST__SIMPLE_TEST_HPP_
 #	include <protest/simple_test.hpp>
 #endif
+#ifndef	INCLUDED__NU11P0__PROTEST__CASE_GEN_HPP_
+#	include <protest/case_gen.hpp>
+#endif
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <memory>
 #include <tuple>
+#include <vector>
 
 namespace	nu11p0 {
 namespace	protest {
@@ -36,72 +45,272 @@ struct	PreconditionAlwaysTrue {
 	}
 }; // struct PreconditionAlwaysTrue
 
+//! Case budget shared by all types of generic::test().
+/*!
+ * generic::test() の maxCount に渡すと、全体の予算を型ごとに配分する。
+ * 配分は値の数の対数(ビット数)に比例させる。
+ * Unique や Exhaustive のように同じケースを繰り返さない生成器では、値の数を超える分は他の型に回す。
+ * 時間で指定した場合は、まず各型を calibrationCases 個ずつ実行して1ケースあたりの時間を計り、
+ * 残りの時間を同じ比で分けて、それぞれの時間に収まる数のケースを実行する。
+ */
+struct	AdaptiveBudget {
+	//! 全ての型で合わせたケースの数。0なら totalTime で配分する。
+	size_t			totalCases;
+	//! 全ての型で合わせた時間。
+	std::chrono::nanoseconds	totalTime;
+	//! 時間を計るために最初に実行するケースの数(型ごと)。
+	size_t			calibrationCases;
+	explicit AdaptiveBudget(size_t cases)
+	:totalCases(cases)
+	,totalTime()
+	,calibrationCases()
+	{}
+	explicit AdaptiveBudget(std::chrono::nanoseconds time, size_t calibration=100)
+	:totalCases()
+	,totalTime(time)
+	,calibrationCases(calibration)
+	{}
+}; // struct AdaptiveBudget
+
+//! Number of distinct values of the type, or SIZE_MAX if it does not fit in size_t.
+/*!
+ * 整数型以外は値の数がわからないものとして SIZE_MAX を返す。
+ */
+template <typename T>
+constexpr size_t		domainSize(void)
+{
+	constexpr int	bits = std::numeric_limits<T>::digits + std::numeric_limits<T>::is_signed;
+	if(!std::is_integral<T>{} || (bits >= std::numeric_limits<size_t>::digits)) {
+		return	SIZE_MAX;
+	}
+	// 剰余は、上で除いた場合のシフト幅の警告を避けるため。
+	return	static_cast<size_t>(1) << (bits % std::numeric_limits<size_t>::digits);
+}
+
 namespace	detail {
-	template <typename param_type, typename TCG, typename F, typename PreCon>
-	TestResult		testImpl(TCG &&testcaseGenerator, const std::string &abstract, const std::string &caseDescription, const F &f, const PreCon &precon, size_t maxCount, std::ostream &ost, std::function<void(std::ostream &, const TestResult &)> &printer)
+	//! Split the budget in proportion to the weights, without exceeding the caps.
+	/*!
+	 * 型iは weights[i] に比例した予算を受け取り、それを costs[i] で割った数のケースを実行する。
+	 * caps[i] を超える分は、上限に達していない型に配り直す。
+	 * \return 型ごとのケースの数。
+	 */
+	std::vector<size_t>	allocateBudget(const std::vector<double> &weights, const std::vector<double> &costs, const std::vector<size_t> &caps, double budget);
+	//! Weight of the type for AdaptiveBudget: log2 of the number of values.
+	template <typename T>
+	constexpr double		budgetWeight(void)
+	{
+		constexpr int	bits = std::numeric_limits<T>::digits + std::numeric_limits<T>::is_signed;
+		return	(std::is_integral<T>{} && (bits < 64)) ? static_cast<double>(bits) : 64.0;
+	}
+	//! Whether the generator never repeats a case, so that cases beyond the domain size are pointless.
+	template <typename Gen>
+	struct	IsNonRepeating : std::false_type {};
+	template <typename T>
+	struct	IsNonRepeating<case_gen::Exhaustive<T>> : std::true_type {};
+	template <typename T, typename Gen, typename Hash>
+	struct	IsNonRepeating<case_gen::Unique<T, Gen, Hash>> : std::true_type {};
+	//! Maximum number of cases worth running: the domain size for non-repeating generators.
+	/*!
+	 * Random などは値を重複して生成するので、値の数より多く試す意味がある(打ち切らない)。
+	 */
+	template <template<class> class TCG, typename T>
+	constexpr size_t		caseCap(void)
+	{
+		return	IsNonRepeating<TCG<T>>::value ? domainSize<T>() : SIZE_MAX;
+	}
+	//! Per-type counts, from a single count.
+	template <size_t N, typename Count>
+	auto			typeCounts(Count count)
+		-> std::enable_if_t<std::is_integral<Count>{}, std::array<size_t, N>>
+	{
+		std::array<size_t, N>	ret;
+		ret.fill(static_cast<size_t>(count));
+		return	ret;
+	}
+	//! Per-type counts, from an array of counts.
+	template <size_t N, typename Count>
+	std::array<size_t, N>	typeCounts(const std::array<Count, N> &counts)
+	{
+		std::array<size_t, N>	ret;
+		std::copy(counts.begin(), counts.end(), ret.begin());
+		return	ret;
+	}
+	//! AdaptiveBudget is passed through.
+	template <size_t N>
+	const AdaptiveBudget	&typeCounts(const AdaptiveBudget &budget)
+	{
+		return	budget;
+	}
+	template <typename Tuple, size_t... Is>
+	std::array<size_t, sizeof...(Is)>	typeCountsImpl(const Tuple &counts, std::index_sequence<Is...>)
+	{
+		return	{{static_cast<size_t>(std::get<Is>(counts))...}};
+	}
+	//! Per-type counts, from a tuple of counts.
+	template <size_t N, typename... Counts>
+	auto			typeCounts(const std::tuple<Counts...> &counts)
+		-> std::enable_if_t<(sizeof...(Counts) == N), std::array<size_t, N>>
 	{
-		bool			ostreamAvailable = std::addressof(ost);
-		protest::SimpleTest<param_type>	test(
-				std::string(abstract),
+		return	typeCountsImpl(counts, std::index_sequence_for<Counts...>());
+	}
+	//! Test for one of the types.
+	/*!
+	 * AdaptiveBudget では同じ型のテストを複数回に分けて実行するので、
+	 * テストと生成器をまとめて保持し、続きから実行できるようにする。
+	 */
+	class	TypeTestBase {
+		public:
+			virtual ~TypeTestBase() = default;
+			//! Run at most count more cases.
+			virtual const TestResult	&run(size_t count, std::ostream &ost) = 0;
+			//! True if the generator ran out of cases.
+			virtual bool	exhausted(void) const = 0;
+	}; // class TypeTestBase
+	template <template<class> class TCG, typename param_type, typename F, typename PreCon>
+	class	TypeTest : public TypeTestBase {
+		private:
+			protest::SimpleTest<param_type>	m_test;
+			TCG<param_type>	m_generator;
+			std::string		m_caseDescription;
+			TestResult		m_result;
+			bool			m_exhausted;
+		public:
+			TypeTest(std::string &&abstract, const std::string &caseDescription, const F &f, const PreCon &precon)
+			:m_test(std::move(abstract), f, precon)
+			,m_generator()
+			,m_caseDescription(caseDescription)
+			,m_result()
+			,m_exhausted(false)
+			{}
+			const TestResult	&run(size_t count, std::ostream &ost) override
+			{
+				if(m_exhausted) {
+					return	m_result;
+				}
+				const size_t	before = m_result.passCount;
+				// 生成器は左辺値で渡し、次の run() で続きから使う。
+				m_result = m_test.runTest(std::string(m_caseDescription), m_generator, count, ost);
+				// 失敗せずに count 個に届かなかったのは、生成器が尽きたとき。
+				m_exhausted = !m_result.isTestFailed() && (m_result.passCount - before < count);
+				return	m_result;
+			}
+			bool			exhausted(void) const override
+			{
+				return	m_exhausted;
+			}
+	}; // class TypeTest
+	template <template<class> class TCG, typename param_type, typename F, typename PreCon>
+	std::unique_ptr<TypeTestBase>	makeTypeTest(size_t index, const std::string &abstract, const std::string &caseDescription, const F &f, const PreCon &precon)
+	{
+		return	std::unique_ptr<TypeTestBase>(new TypeTest<TCG, param_type, F, PreCon>(
+				abstract + " for " + std::to_string(index) + "th type",
+				caseDescription,
 				f,
-				precon
-			);
-		auto			result = test.runTest(
-				std::string(caseDescription),
-				std::forward<TCG>(testcaseGenerator),
-				maxCount,
-				ost);
-		if(ostreamAvailable && printer) {
+				precon));
+	}
+	//! Type-erased tests for each type of Params.
+	/*!
+	 * 型ごとのテストを作る関数を表にしておき、型の数だけ再帰的に実体化しないようにする。
+	 */
+	template <typename F, typename PreCon>
+	struct	TypeTestTable {
+		using	Factory = std::unique_ptr<TypeTestBase> (*)(size_t, const std::string &, const std::string &, const F &, const PreCon &);
+		const Factory	*factories;
+		//! 型ごとのケースの数の上限(caseCap())。
+		const size_t	*caps;
+		const double	*weights;
+		size_t			size;
+	}; // struct TypeTestTable
+	template <template<class> class TCG, typename Params, typename F, typename PreCon, size_t... Is>
+	TypeTestTable<F, PreCon>	typeTestTable(std::index_sequence<Is...>)
+	{
+		static constexpr typename TypeTestTable<F, PreCon>::Factory	factories[] = {&makeTypeTest<TCG, std::tuple_element_t<Is, Params>, F, PreCon>...};
+		static constexpr size_t	caps[] = {caseCap<TCG, std::tuple_element_t<Is, Params>>()...};
+		static constexpr double	weights[] = {budgetWeight<std::tuple_element_t<Is, Params>>()...};
+		return	{factories, caps, weights, sizeof...(Is)};
+	}
+	inline void		printTypeResult(const TestResult &result, std::ostream &ost, std::function<void(std::ostream &, const TestResult &)> &printer)
+	{
+		if(isOstreamAvailable(ost) && printer) {
 			printer(ost, result);
 		}
-		return	result;
 	}
-	// TODO: maxCountをtupleにして型ごとに指定できるようにする。
-	template <template<class> class TCG, typename Params, typename F, typename PreCon, size_t I=0>
-	auto			testImplInterface(const std::string &abstract, const std::string &caseDescription, const F &f, const PreCon &precon, size_t maxCount, std::ostream &ost, std::function<void(std::ostream &, const TestResult &)> &printer)
-		-> std::enable_if_t<!(I < std::tuple_size<Params>{}-1), SequentialTestResult>
+	//! Run each type with its own count (capped by caseCap()), and stop at the first failure.
+	template <typename F, typename PreCon, size_t N>
+	SequentialTestResult	testImplInterface(const TypeTestTable<F, PreCon> &table, const std::string &abstract, const std::string &caseDescription, const F &f, const PreCon &precon, const std::array<size_t, N> &counts, std::ostream &ost, std::function<void(std::ostream &, const TestResult &)> &printer)
 	{
-		using	param_type = std::tuple_element_t<I, Params>;
 		SequentialTestResult	result;
-		result.result = testImpl<param_type>(
-				TCG<param_type>(),
-				abstract + " for " + std::to_string(I) + "th type",
-				caseDescription,
-				f,
-				precon,
-				maxCount,
-				ost,
-				printer);
-		result.failedIndex = I;
+		for(size_t i = 0; i < table.size; ++i) {
+			auto			test = table.factories[i](i, abstract, caseDescription, f, precon);
+			result.result = test->run(std::min(counts[i], table.caps[i]), ost);
+			result.failedIndex = i;
+			printTypeResult(result.result, ost, printer);
+			if(result.result.isTestFailed()) {
+				break;
+			}
+		}
 		return	result;
 	}
-	template <template<class> class TCG, typename Params, typename F, typename PreCon, size_t I=0>
-	auto			testImplInterface(const std::string &abstract, const std::string &caseDescription, const F &f, const PreCon &precon, size_t maxCount, std::ostream &ost, std::function<void(std::ostream &, const TestResult &)> &printer)
-		-> std::enable_if_t<(I < std::tuple_size<Params>{}-1), SequentialTestResult>
+	//! Spread the budget across the types, and stop at the first failure.
+	template <typename F, typename PreCon>
+	SequentialTestResult	testImplInterface(const TypeTestTable<F, PreCon> &table, const std::string &abstract, const std::string &caseDescription, const F &f, const PreCon &precon, const AdaptiveBudget &budget, std::ostream &ost, std::function<void(std::ostream &, const TestResult &)> &printer)
 	{
-		using	param_type = std::tuple_element_t<I, Params>;
 		SequentialTestResult	result;
-		result.result = testImpl<param_type>(
-				TCG<param_type>(),
-				abstract + " for " + std::to_string(I) + "th type",
-				caseDescription,
-				f,
-				precon,
-				maxCount,
-				ost,
-				printer);
-		result.failedIndex = I;
-		return	result.result.isTestFailed() ? result : testImplInterface<TCG, Params, F, PreCon, I+1>(abstract, caseDescription, f, precon, maxCount, ost, printer);
+		std::vector<std::unique_ptr<TypeTestBase>>	tests(table.size);
+		std::vector<double>	weights(table.weights, table.weights + table.size);
+		std::vector<double>	costs(table.size, 1.0);
+		std::vector<size_t>	caps(table.caps, table.caps + table.size);
+		double			remaining = static_cast<double>(budget.totalCases);
+		if(!budget.totalCases) {
+			// 各型の1ケースあたりの時間を計る。この実行もテストの一部として数える。
+			const auto		startTime = std::chrono::steady_clock::now();
+			for(size_t i = 0; i < table.size; ++i) {
+				tests[i] = table.factories[i](i, abstract, caseDescription, f, precon);
+				const auto		&res = tests[i]->run(std::min(budget.calibrationCases, caps[i]), ost);
+				if(res.isTestFailed()) {
+					result.result = res;
+					result.failedIndex = i;
+					printTypeResult(result.result, ost, printer);
+					return	result;
+				}
+				caps[i] = tests[i]->exhausted() ? 0 : (caps[i] - std::min(caps[i], res.passCount));
+				costs[i] = std::max(1.0, static_cast<double>(res.elapsed.count()) / static_cast<double>(std::max<size_t>(res.passCount, 1)));
+			}
+			const auto		used = std::chrono::steady_clock::now() - startTime;
+			remaining = std::max(0.0, static_cast<double>((budget.totalTime - used).count()));
+		}
+		const auto		counts = allocateBudget(weights, costs, caps, remaining);
+		for(size_t i = 0; i < table.size; ++i) {
+			if(!tests[i]) {
+				tests[i] = table.factories[i](i, abstract, caseDescription, f, precon);
+			}
+			result.result = tests[i]->run(counts[i], ost);
+			result.failedIndex = i;
+			printTypeResult(result.result, ost, printer);
+			if(result.result.isTestFailed()) {
+				break;
+			}
+		}
+		return	result;
 	}
 } // namespace detail
 
+//! Run the test for each type of Params.
+/*!
+ * maxCount には次のいずれかを指定する。
+ * - 整数: 全ての型で同じ数のケースを試す。
+ * - std::array や std::tuple: 型ごとにケースの数を指定する。
+ * - AdaptiveBudget: 全体の予算を型ごとに配分する。
+ * いずれの場合も、 Unique や Exhaustive のように同じケースを繰り返さない生成器では、
+ * 値の数より多いケースは試さない(int8_t なら256個まで)。
+ */
 // FとPreConは複数の型に対するテストで使い回されるため、forwardやmoveは行わない。よってconst参照で受け取る。
 template <template<class> class TCG, typename Params, typename F, typename PreCon, typename Counts>
-SequentialTestResult	test(std::string &&abstract, const std::string &caseDescription, const F &f, const PreCon &precon, Counts maxCount, std::ostream &ost=*static_cast<std::ostream *>(nullptr), std::function<void(std::ostream &, const TestResult &)> printer=printResult)
+SequentialTestResult	test(std::string &&abstract, const std::string &caseDescription, const F &f, const PreCon &precon, const Counts &maxCount, std::ostream &ost=nullOstream(), std::function<void(std::ostream &, const TestResult &)> printer=printResult)
 {
-	SequentialTestResult	result;
-	result = detail::testImplInterface<TCG, Params>(std::forward<std::string>(abstract), caseDescription, f, precon, maxCount, ost, printer);
-	return	result;
+	constexpr size_t	N = std::tuple_size<Params>::value;
+	const auto		table = detail::typeTestTable<TCG, Params, F, PreCon>(std::make_index_sequence<N>());
+	return	detail::testImplInterface(table, abstract, caseDescription, f, precon, detail::typeCounts<N>(maxCount), ost, printer);
 }
 
 } // namespace generic
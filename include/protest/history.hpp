@@ -0,0 +1,80 @@
+/*!
+ * \file   history.hpp
+ * \brief  Outcomes of previous runs, for fail-fast test ordering.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__HISTORY_HPP_
+#define	INCLUDED__NU11P0__PROTEST__HISTORY_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace	nu11p0 {
+namespace	protest {
+
+struct	TestInfo;
+
+//! Outcomes of the previous runs of a test.
+struct	HistoryEntry {
+	//! 前回の実行で失敗したか。
+	bool			lastFailed;
+	//! 実行した回数。
+	size_t			runs;
+	//! 失敗の多さ。実行ごとに半分に減衰させ、失敗したら1を足す。
+	double			failureScore;
+	//! 前回の実行時間。
+	std::chrono::nanoseconds	duration;
+	//! 前回実行したケースの数(pass と skip の合計)。
+	size_t			cases;
+	HistoryEntry()
+	:lastFailed(false)
+	,runs()
+	,failureScore()
+	,duration()
+	,cases()
+	{}
+}; // struct HistoryEntry
+
+//! Local history file of test outcomes.
+/*!
+ * 登録されたテストの名前ごとに、前回の結果、実行時間、ケースの数を記録する。
+ * ファイルは1行1テストのテキストで、名前の後にタブ区切りで数値が並ぶ。
+ *     name<TAB>lastFailed<TAB>runs<TAB>failureScore<TAB>duration_ns<TAB>cases
+ */
+class	TestHistory {
+	private:
+		std::map<std::string, HistoryEntry>	m_entries;
+	public:
+		TestHistory();
+		//! Load the file. A missing file is an empty history.
+		/*!
+		 * \return false if the file exists but cannot be parsed.
+		 */
+		bool			load(const std::string &path);
+		//! Write the file (through a temporary file, so that an interrupted run does not break it).
+		bool			save(const std::string &path) const;
+		//! Entry of the test. nullptr if it has never run.
+		const HistoryEntry	*find(const std::string &name) const;
+		//! Record an outcome of the test.
+		void			update(const std::string &name, bool failed, std::chrono::nanoseconds duration, size_t cases);
+		//! Indices of the tests in the order to run them to find failures early.
+		/*!
+		 * 失敗の多い(直前に失敗したものが最も多い)順、次に前回の実行時間が短い順に並べる。
+		 * 一度も実行していないテストは、失敗していない実行時間0のテストとして扱う。
+		 * 同じ順位のものは元の順を保つ。 tests 自体は並べ替えない。
+		 */
+		std::vector<size_t>	schedule(const std::vector<const TestInfo *> &tests) const;
+}; // class TestHistory
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__HISTORY_HPP_
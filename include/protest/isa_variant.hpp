@@ -0,0 +1,227 @@
+/*!
+ * \file   isa_variant.hpp
+ * \brief  Differential conditions across instruction set variants of a kernel.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__ISA_VARIANT_HPP_
+#define	INCLUDED__NU11P0__PROTEST__ISA_VARIANT_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+#ifndef	INCLUDED__NU11P0__PROTEST__EQUIVALENT_HPP_
+#	include <protest/equivalent.hpp>
+#endif
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace	nu11p0 {
+namespace	protest {
+
+//! Instruction set levels of kernel variants.
+enum class	IsaLevel {
+	//! どの CPU でも実行できる。
+	Scalar,
+	Sse42,
+	Avx2,
+	//! AVX-512F 。
+	Avx512,
+};
+
+//! Name of the level for reports, e.g. "AVX2".
+const char		*isaName(IsaLevel level);
+
+//! True if the host CPU (and OS) can execute code of the level.
+/*!
+ * x86 では __builtin_cpu_supports で判定する。それ以外のアーキテクチャでは Scalar のみ実行できるとみなす。
+ */
+bool			isaSupported(IsaLevel level);
+
+//! Table of variants of a kernel, one per instruction set level.
+/*!
+ * 実行時ディスパッチされるカーネルの各実装を登録する。
+ * target_clones で作られた複製は個別に呼び出せないので、
+ * `__attribute__((target("avx2")))' 等を付けた関数をそれぞれ登録すること。
+ *
+ * 最初に登録した変種が、他の変種の出力を比べる基準になる(普通は Scalar)。
+ */
+template <typename Signature>
+class	KernelVariants {
+	public:
+		using	function_type = std::function<Signature>;
+		struct	Variant {
+			IsaLevel		level;
+			function_type	fun;
+		};
+	private:
+		std::vector<Variant>	m_variants;
+	public:
+		KernelVariants()
+		:m_variants()
+		{}
+		template <typename F>
+		KernelVariants	&add(IsaLevel level, F &&f) {
+			m_variants.push_back(Variant{level, function_type(std::forward<F>(f))});
+			return	*this;
+		}
+		const std::vector<Variant>	&variants(void) const {
+			return	m_variants;
+		}
+		//! Variants which the host can execute, in registered order.
+		std::vector<Variant>	supported(void) const {
+			std::vector<Variant>	ret;
+			for(const auto &v : m_variants) {
+				if(isaSupported(v.level)) {
+					ret.push_back(v);
+				}
+			}
+			return	ret;
+		}
+		//! Levels of variants which the host cannot execute.
+		std::vector<IsaLevel>	skipped(void) const {
+			std::vector<IsaLevel>	ret;
+			for(const auto &v : m_variants) {
+				if(!isaSupported(v.level)) {
+					ret.push_back(v.level);
+				}
+			}
+			return	ret;
+		}
+}; // class KernelVariants
+
+namespace	detail {
+
+	//! "SSE4.2, AVX2 differ from scalar" for reports.
+	std::string		describeDifference(const std::vector<IsaLevel> &levels, IsaLevel base);
+
+} // namespace detail
+
+//! Check that every variant executable on the host gives the same output as the first one.
+/*!
+ * 実行できない変種は構築時に除かれる( skipped() で確認できる)。
+ * 失敗時の理由には、基準と異なる出力を返した全ての命令セットと、その出力、 ULP 距離を含める。
+ */
+template <typename Param, typename Result, typename Compare=compare::Exact>
+class	AcrossVariants {
+	public:
+		using	param_type = Param;
+		using	result_type = Result;
+		using	variants_type = KernelVariants<result_type(const param_type &)>;
+	private:
+		std::vector<typename variants_type::Variant>	m_variants;
+		std::vector<IsaLevel>	m_skipped;
+		Compare			m_compare;
+	public:
+		AcrossVariants(const variants_type &variants, Compare compare=Compare())
+		:m_variants(variants.supported())
+		,m_skipped(variants.skipped())
+		,m_compare(std::move(compare))
+		{}
+		~AcrossVariants() = default;
+		AcrossVariants(const AcrossVariants &) = default;
+		AcrossVariants(AcrossVariants &&) = default;
+		const std::vector<IsaLevel>	&skipped(void) const {
+			return	m_skipped;
+		}
+		CheckResult		operator()(const param_type &arg)
+		{
+			CheckResult		ret;
+			if(m_variants.empty()) {
+				ret.reason.emplace("no variant can be executed on this CPU");
+				return	ret;
+			}
+			const auto		&base = m_variants.front();
+			const result_type	expected = base.fun(arg);
+			std::vector<IsaLevel>	differs;
+			std::string		outputs;
+			for(size_t i = 1; i < m_variants.size(); ++i) {
+				const result_type	actual = m_variants[i].fun(arg);
+				if(!m_compare(actual, expected)) {
+					differs.push_back(m_variants[i].level);
+					outputs += std::string(", ") + isaName(m_variants[i].level) + "=" + detail::describeValue(actual)
+							+ detail::describeUlps(actual, expected);
+				}
+			}
+			if(!differs.empty()) {
+				ret.reason.emplace(detail::describeDifference(differs, base.level)
+						+ ": " + isaName(base.level) + "=" + detail::describeValue(expected) + outputs);
+			}
+			return	ret;
+		}
+}; // class AcrossVariants
+
+//! Check that every batch kernel variant executable on the host gives the same outputs as the first one.
+/*!
+ * BatchEquivalent と同じく、ケースの配列を各変種のカーネル `void(const T *in, Result *out, size_t n)' に通す。
+ * 失敗時の理由には、異なる命令セットごとに最初に食い違った要素の位置、入力、出力、 ULP 距離を含める。
+ */
+template <typename T, typename Result, typename Compare=compare::Exact>
+class	BatchAcrossVariants {
+	public:
+		using	param_type = std::vector<T>;
+		using	result_type = Result;
+		using	variants_type = KernelVariants<void(const T *, result_type *, size_t)>;
+	private:
+		std::vector<typename variants_type::Variant>	m_variants;
+		std::vector<IsaLevel>	m_skipped;
+		Compare			m_compare;
+		//! 変種ごとの出力。次のケースで再利用する。
+		std::vector<std::vector<result_type>>	m_outputs;
+	public:
+		BatchAcrossVariants(const variants_type &variants, Compare compare=Compare())
+		:m_variants(variants.supported())
+		,m_skipped(variants.skipped())
+		,m_compare(std::move(compare))
+		,m_outputs(m_variants.size())
+		{}
+		~BatchAcrossVariants() = default;
+		BatchAcrossVariants(const BatchAcrossVariants &) = default;
+		BatchAcrossVariants(BatchAcrossVariants &&) = default;
+		const std::vector<IsaLevel>	&skipped(void) const {
+			return	m_skipped;
+		}
+		CheckResult		operator()(const param_type &batch)
+		{
+			CheckResult		ret;
+			if(m_variants.empty()) {
+				ret.reason.emplace("no variant can be executed on this CPU");
+				return	ret;
+			}
+			const size_t	n = batch.size();
+			for(size_t v = 0; v < m_variants.size(); ++v) {
+				m_outputs[v].resize(n);
+				m_variants[v].fun(batch.data(), m_outputs[v].data(), n);
+			}
+			const auto		&expected = m_outputs.front();
+			const char		*baseName = isaName(m_variants.front().level);
+			std::vector<IsaLevel>	differs;
+			std::string		details;
+			for(size_t v = 1; v < m_variants.size(); ++v) {
+				const auto		&actual = m_outputs[v];
+				const size_t	i = detail::firstMismatch(actual.data(), expected.data(), n, m_compare);
+				if(i < n) {
+					const char		*name = isaName(m_variants[v].level);
+					differs.push_back(m_variants[v].level);
+					details += std::string("; ") + name + " at index " + std::to_string(i)
+							+ ": input=" + detail::describeValue(batch[i])
+							+ ", " + name + "=" + detail::describeValue(actual[i])
+							+ ", " + baseName + "=" + detail::describeValue(expected[i])
+							+ detail::describeUlps(actual[i], expected[i]);
+				}
+			}
+			if(!differs.empty()) {
+				ret.reason.emplace(detail::describeDifference(differs, m_variants.front().level)
+						+ " (batch of " + std::to_string(n) + ")" + details);
+			}
+			return	ret;
+		}
+}; // class BatchAcrossVariants
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__ISA_VARIANT_HPP_
@@ -155,5 +155,7 @@
 #undef		SGR_NO_NEGATIVE
 
 #undef		SGR_UNDEF
+// Allow the header to be included again after undef.
+#undef		INCLUDED__NU11P0__SPIRAL_OUCH__LOLIGGER_SGR_MACRO_HPP_
 
 #endif	// ifndef INCLUDED__NU11P0__SPIRAL_OUCH__LOLIGGER_SGR_MACRO_HPP_
@@ -0,0 +1,256 @@
+/*!
+ * \file   perf_condition.hpp
+ * \brief  Conditions on the execution time of functions.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__PERF_CONDITION_HPP_
+#define	INCLUDED__NU11P0__PROTEST__PERF_CONDITION_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace	nu11p0 {
+namespace	protest {
+
+//! Options of measurement for performance conditions.
+struct	PerfOptions {
+	//! 計測前に捨てる試行の数。キャッシュや分岐予測を温める。
+	size_t			warmup;
+	//! 計測する標本の数。
+	size_t			repetitions;
+	//! 一つの標本の最短時間。これより短い関数は、複数回まとめて呼んで時間を測る。
+	std::chrono::nanoseconds	minSampleTime;
+	//! 中央値の信頼区間の信頼水準。
+	double			confidence;
+	//! 中央値から MAD(中央絶対偏差) のこの倍数以上遅い標本は外れ値として捨てる。0なら捨てない。
+	/*!
+	 * 計測のノイズは遅くなる方向にしか出ないので、速い側の標本は捨てない。
+	 * MAD には中央値の1%の下限を設け、時計の分解能が粗くて MAD が0になっても中央値より遅い標本を全て捨てないようにする。
+	 */
+	double			outlierThreshold;
+	PerfOptions()
+	:warmup(3)
+	,repetitions(31)
+	,minSampleTime(std::chrono::microseconds(10))
+	,confidence(0.95)
+	,outlierThreshold(5.0)
+	{}
+}; // struct PerfOptions
+
+//! Robust summary of measured samples.
+struct	PerfSummary {
+	//! 中央値。
+	double			median;
+	//! 中央値の信頼区間。
+	double			lower;
+	double			upper;
+	//! 外れ値を除いた標本の数。
+	size_t			samples;
+	//! 外れ値として除いた標本の数。
+	size_t			rejected;
+	PerfSummary()
+	:median()
+	,lower()
+	,upper()
+	,samples()
+	,rejected()
+	{}
+}; // struct PerfSummary
+
+namespace	detail {
+	//! Summarize the samples: reject outliers, then take median and its confidence interval.
+	/*!
+	 * 信頼区間は順序統計量によるもので、分布を仮定しない。
+	 * samples は並べ替えられる。
+	 */
+	PerfSummary		summarizeSamples(std::vector<double> &samples, const PerfOptions &opts);
+	//! Format nanoseconds with a suitable unit (ns, us, ms or s).
+	std::string		formatNanoseconds(double ns);
+	//! Format a ratio of times: "1.23x".
+	std::string		formatRatio(double ratio);
+	//! Describe the summary: "1.2us (95% CI [1.1us, 1.3us], 29 samples, 2 outliers rejected)".
+	std::string		describeSummary(const PerfSummary &summary, const PerfOptions &opts, std::string (*format)(double));
+
+	//! Prevent the compiler from removing the computation of the value.
+	template <typename T>
+	inline void		keep(const T &val)
+	{
+#if defined(__GNUC__)
+		__asm__ __volatile__("" : : "r"(&val) : "memory");
+#else
+		static volatile const void	*sink;
+		sink = &val;
+#endif
+	}
+
+	//! Wrap the function under test so that its result is not optimized away.
+	template <typename Param, typename F>
+	auto			measurable(F &&f)
+		-> std::enable_if_t<
+			std::is_void<std::result_of_t<std::decay_t<F>(const Param &)>>{},
+			std::function<void(const Param &)>>
+	{
+		return	std::forward<F>(f);
+	}
+	template <typename Param, typename F>
+	auto			measurable(F &&f)
+		-> std::enable_if_t<
+			!std::is_void<std::result_of_t<std::decay_t<F>(const Param &)>>{},
+			std::function<void(const Param &)>>
+	{
+		return	[f = std::forward<F>(f)](const Param &arg) mutable {
+				keep(f(arg));
+			};
+	}
+
+	//! Number of calls per sample so that one sample takes at least opts.minSampleTime.
+	template <typename Param>
+	size_t			calibrate(const std::function<void(const Param &)> &f, const Param &arg, const PerfOptions &opts)
+	{
+		size_t			iterations = 1;
+		for(;;) {
+			const auto		start = std::chrono::steady_clock::now();
+			for(size_t i = 0; i < iterations; ++i) {
+				f(arg);
+			}
+			const auto		elapsed = std::chrono::steady_clock::now() - start;
+			if((elapsed >= opts.minSampleTime) || (iterations >= (SIZE_MAX / 2))) {
+				return	iterations;
+			}
+			iterations *= 2;
+		}
+	}
+
+	//! Time of one call in nanoseconds, averaged over the iterations.
+	template <typename Param>
+	double			sample(const std::function<void(const Param &)> &f, const Param &arg, size_t iterations)
+	{
+		const auto		start = std::chrono::steady_clock::now();
+		for(size_t i = 0; i < iterations; ++i) {
+			f(arg);
+		}
+		const auto		elapsed = std::chrono::steady_clock::now() - start;
+		return	static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())
+			/ static_cast<double>(iterations);
+	}
+} // namespace detail
+
+//! Check that the function finishes within the budget for each case.
+/*!
+ * 各ケースについて関数を opts.repetitions 回計測し、外れ値を除いた中央値の信頼区間を求める。
+ * 信頼区間の下限が予算を超えた場合(ノイズでは説明できないほど遅い場合)に失敗する。
+ * reason には計測した数値が書かれる。
+ *
+ * 使用例:
+ *     protest::SimpleTest<std::vector<int>>	test("sort latency",
+ *         protest::WithinLatency<std::vector<int>>([](const std::vector<int> &v) { ... }, std::chrono::microseconds(50)));
+ */
+template <typename Param>
+class	WithinLatency {
+	public:
+		using	param_type = Param;
+	private:
+		std::function<void(const param_type &)>	m_fun;
+		std::chrono::nanoseconds	m_budget;
+		PerfOptions		m_opts;
+		//! 標本のバッファ。ケースごとに使い回す。
+		std::vector<double>	m_samples;
+	public:
+		template <typename F>
+		WithinLatency(F &&f, std::chrono::nanoseconds budget, PerfOptions opts=PerfOptions())
+		:m_fun(detail::measurable<param_type>(std::forward<F>(f)))
+		,m_budget(budget)
+		,m_opts(opts)
+		,m_samples()
+		{}
+		CheckResult		operator()(const param_type &arg)
+		{
+			CheckResult		ret;
+			const size_t	iterations = detail::calibrate(m_fun, arg, m_opts);
+			for(size_t i = 0; i < m_opts.warmup; ++i) {
+				detail::sample(m_fun, arg, iterations);
+			}
+			m_samples.clear();
+			for(size_t i = 0; i < m_opts.repetitions; ++i) {
+				m_samples.push_back(detail::sample(m_fun, arg, iterations));
+			}
+			const auto		summary = detail::summarizeSamples(m_samples, m_opts);
+			const auto		budget = static_cast<double>(m_budget.count());
+			if(summary.lower > budget) {
+				ret.reason.emplace("median " + detail::describeSummary(summary, m_opts, detail::formatNanoseconds)
+						+ " exceeds the budget " + detail::formatNanoseconds(budget));
+			}
+			return	ret;
+		}
+}; // class WithinLatency
+
+//! Check that the function f is faster than the reference g for each case.
+/*!
+ * f と g を交互に計測し(時間による変動を打ち消すため)、各組の時間の比 f/g の中央値と信頼区間を求める。
+ * 信頼区間の下限が maxRatio を超えた場合、すなわち f が g の maxRatio 倍より長くかかることが
+ * ノイズを考慮しても確かな場合に失敗する。
+ * 例えば maxRatio=0.5 とすると、 f が g の倍以上速いことを要求する(遅くとも半分の時間)。
+ * 同程度の速さの関数を多数のケースで比べると偶然失敗するケースが出るので、 maxRatio には余裕を持たせること。
+ */
+template <typename Param>
+class	FasterThan {
+	public:
+		using	param_type = Param;
+	private:
+		std::function<void(const param_type &)>	m_fun;
+		std::function<void(const param_type &)>	m_reference;
+		double			m_maxRatio;
+		PerfOptions		m_opts;
+		std::vector<double>	m_ratios;
+	public:
+		template <typename F, typename G>
+		FasterThan(F &&f, G &&g, double maxRatio=1.0, PerfOptions opts=PerfOptions())
+		:m_fun(detail::measurable<param_type>(std::forward<F>(f)))
+		,m_reference(detail::measurable<param_type>(std::forward<G>(g)))
+		,m_maxRatio(maxRatio)
+		,m_opts(opts)
+		,m_ratios()
+		{}
+		CheckResult		operator()(const param_type &arg)
+		{
+			CheckResult		ret;
+			const size_t	iterF = detail::calibrate(m_fun, arg, m_opts);
+			const size_t	iterG = detail::calibrate(m_reference, arg, m_opts);
+			for(size_t i = 0; i < m_opts.warmup; ++i) {
+				detail::sample(m_fun, arg, iterF);
+				detail::sample(m_reference, arg, iterG);
+			}
+			m_ratios.clear();
+			for(size_t i = 0; i < m_opts.repetitions; ++i) {
+				// 順番による偏りを避けるため、先に測る方を交互に入れ替える。
+				double			tf, tg;
+				if(i % 2) {
+					tg = detail::sample(m_reference, arg, iterG);
+					tf = detail::sample(m_fun, arg, iterF);
+				} else {
+					tf = detail::sample(m_fun, arg, iterF);
+					tg = detail::sample(m_reference, arg, iterG);
+				}
+				m_ratios.push_back(tf / ((tg > 0.0) ? tg : 1.0));
+			}
+			const auto		summary = detail::summarizeSamples(m_ratios, m_opts);
+			if(summary.lower > m_maxRatio) {
+				ret.reason.emplace("time ratio " + detail::describeSummary(summary, m_opts, detail::formatRatio)
+						+ " is not below " + detail::formatRatio(m_maxRatio));
+			}
+			return	ret;
+		}
+}; // class FasterThan
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__PERF_CONDITION_HPP_
@@ -0,0 +1,96 @@
+/*!
+ * \file   perf_counter.hpp
+ * \brief  Hardware and software performance counters.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__PERF_COUNTER_HPP_
+#define	INCLUDED__NU11P0__PROTEST__PERF_COUNTER_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+
+namespace	nu11p0 {
+namespace	protest {
+
+//! Performance counters of the current thread.
+/*!
+ * Linux の perf_event_open で、命令数、サイクル数、キャッシュミス、分岐予測ミスを計測する。
+ * ソフトウェアカウンタ(task-clock, page-faults)は、ハードウェアカウンタとは別のグループとして常に開く。
+ * ハードウェアカウンタが使えない場合(仮想マシンやコンテナ等)は、ソフトウェアカウンタだけで計測する。
+ * ソフトウェアカウンタが開けない場合は、スレッドのCPU時間とページフォルトの数(getrusage)で代用する。
+ *
+ * start() と stop() の間の値だけが read() の値に加算される。
+ * カウンタは start() を呼んだスレッドのものなので、 start(), stop() は同じスレッドで呼ぶこと。
+ */
+class	PerfCounterGroup {
+	public:
+		enum class	Source {
+			//! 開いていない。
+			None,
+			//! ハードウェアカウンタとソフトウェアカウンタ(または getrusage)。
+			Hardware,
+			Software,
+			//! perf_event_open が使えず、 getrusage 等で代用している。
+			Rusage,
+		};
+	private:
+		//! 開いたイベントの fd 。グループごとに連続して並び、それぞれの先頭がリーダー。
+		int				m_fds[PerfCounts::EventCount];
+		PerfCounts::Event	m_events[PerfCounts::EventCount];
+		size_t			m_count;
+		//! 各グループのリーダーの位置。
+		size_t			m_leaders[2];
+		size_t			m_groups;
+		Source			m_source;
+		//! 実行時間とページフォルトを getrusage 等で計測する。
+		bool			m_rusage;
+		//! m_rusage の場合の、 start() 時点の値。
+		uint64_t		m_startClock;
+		uint64_t		m_startFaults;
+		PerfCounts		m_accumulated;
+	public:
+		PerfCounterGroup();
+		~PerfCounterGroup();
+		PerfCounterGroup(const PerfCounterGroup &) = delete;
+		PerfCounterGroup	&operator=(const PerfCounterGroup &) = delete;
+		//! Open counters for the current thread. Does nothing if already opened.
+		Source			open(void);
+		void			close(void);
+		Source			source(void) const;
+		void			start(void);
+		void			stop(void);
+		//! Counts accumulated since open() or reset().
+		PerfCounts		read(void);
+		void			reset(void);
+}; // class PerfCounterGroup
+
+//! Run the counters while the scope is alive, even if the scope is left by an exception.
+class	PerfCounterScope {
+	private:
+		PerfCounterGroup	*m_group;
+	public:
+		//! Does nothing if group is nullptr.
+		explicit		PerfCounterScope(PerfCounterGroup *group)
+		:m_group(group)
+		{
+			if(m_group) {
+				m_group->start();
+			}
+		}
+		~PerfCounterScope()
+		{
+			if(m_group) {
+				m_group->stop();
+			}
+		}
+		PerfCounterScope(const PerfCounterScope &) = delete;
+		PerfCounterScope	&operator=(const PerfCounterScope &) = delete;
+}; // class PerfCounterScope
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__PERF_COUNTER_HPP_
@@ -9,9 +9,19 @@
 #ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
 #define	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
 
+#include <chrono>
+#include <cstddef>
+#include <functional>
 #include <iosfwd>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
 #include <type_traits>
+#include <typeinfo>
 #include <tuple>
+#include <utility>
+#include <vector>
 // To get macros such as UINT64_MAX, define __STDC_LIMIT_MACROS.
 // For detail, see P257 of ISO/IEC 9899:1999 (N1124),
 // "7.18.2 Limits of specified-width integer types".
@@ -149,6 +159,317 @@ struct	Printer {
 }; // struct Printer
 #endif
 
+//! Exception thrown by case_cast() on type mismatch.
+class	bad_case_cast : public std::bad_cast {
+	public:
+		const char		*what(void) const noexcept override {
+			return	"nu11p0::protest::bad_case_cast";
+		}
+}; // class bad_case_cast
+
+//! Type-erased holder of a test case.
+/*!
+ * ns_any::any と異なり、小さなオブジェクト(inlineSize以下で、例外を投げずにムーブできるもの)は
+ * ヒープを使わずに内部のバッファに格納する。
+ * std::vector や std::string 自体(要素ではなく)もこの大きさに収まるため、
+ * コンテナのテストケースを保存する場合もムーブのみで済む。
+ *
+ * 値を取り出すには case_cast<T>() を使う。
+ */
+class	CaseHolder {
+	public:
+		//! Objects up to this size are stored without heap allocation.
+		static constexpr size_t	inlineSize = 4 * sizeof(void *);
+	private:
+		union	Storage {
+			std::aligned_storage_t<inlineSize, alignof(std::max_align_t)>	buffer;
+			void			*ptr;
+		};
+		struct	Operations {
+			const std::type_info	&(*type)(void);
+			void			(*destroy)(Storage &);
+			//! dstは未初期化。
+			void			(*copy)(const Storage &src, Storage &dst);
+			//! dstは未初期化。srcは破棄される。
+			void			(*move)(Storage &src, Storage &dst);
+			const void		*(*get)(const Storage &);
+		};
+		template <typename T>
+		using	IsInline = std::integral_constant<bool,
+				(sizeof(T) <= inlineSize)
+				&& (alignof(std::max_align_t) % alignof(T) == 0)
+				&& std::is_nothrow_move_constructible<T>::value
+			>;
+		template <typename T, bool=IsInline<T>::value>
+		struct	OperationsImpl;
+		template <typename T>
+		struct	OperationsImpl<T, true> {
+			static const std::type_info	&type(void) {
+				return	typeid(T);
+			}
+			static void		destroy(Storage &s) {
+				reinterpret_cast<T *>(&s.buffer)->~T();
+			}
+			static void		copy(const Storage &src, Storage &dst) {
+				copyImpl(src, dst, std::is_copy_constructible<T>{});
+			}
+			static void		copyImpl(const Storage &src, Storage &dst, std::true_type) {
+				new(&dst.buffer) T(*reinterpret_cast<const T *>(&src.buffer));
+			}
+			static void		copyImpl(const Storage &, Storage &, std::false_type) {
+				throw	std::logic_error("protest::CaseHolder: test case is not copy constructible");
+			}
+			static void		move(Storage &src, Storage &dst) {
+				new(&dst.buffer) T(std::move(*reinterpret_cast<T *>(&src.buffer)));
+				destroy(src);
+			}
+			static const void	*get(const Storage &s) {
+				return	&s.buffer;
+			}
+		};
+		template <typename T>
+		struct	OperationsImpl<T, false> {
+			static const std::type_info	&type(void) {
+				return	typeid(T);
+			}
+			static void		destroy(Storage &s) {
+				delete	static_cast<T *>(s.ptr);
+			}
+			static void		copy(const Storage &src, Storage &dst) {
+				copyImpl(src, dst, std::is_copy_constructible<T>{});
+			}
+			static void		copyImpl(const Storage &src, Storage &dst, std::true_type) {
+				dst.ptr = new T(*static_cast<const T *>(src.ptr));
+			}
+			static void		copyImpl(const Storage &, Storage &, std::false_type) {
+				throw	std::logic_error("protest::CaseHolder: test case is not copy constructible");
+			}
+			static void		move(Storage &src, Storage &dst) {
+				dst.ptr = src.ptr;
+			}
+			static const void	*get(const Storage &s) {
+				return	s.ptr;
+			}
+		};
+		template <typename T>
+		static const Operations	*operationsFor(void) {
+			using	Impl = OperationsImpl<T>;
+			static const Operations	ops = {&Impl::type, &Impl::destroy, &Impl::copy, &Impl::move, &Impl::get};
+			return	&ops;
+		}
+		Storage			m_storage;
+		const Operations	*m_ops;
+	public:
+		CaseHolder() noexcept
+		:m_storage()
+		,m_ops()
+		{}
+		template <typename T, typename=std::enable_if_t<!std::is_same<std::decay_t<T>, CaseHolder>::value>>
+		CaseHolder(T &&val)
+		:m_storage()
+		,m_ops()
+		{
+			emplace<std::decay_t<T>>(std::forward<T>(val));
+		}
+		CaseHolder(const CaseHolder &other)
+		:m_storage()
+		,m_ops()
+		{
+			if(other.m_ops) {
+				other.m_ops->copy(other.m_storage, m_storage);
+				m_ops = other.m_ops;
+			}
+		}
+		CaseHolder(CaseHolder &&other) noexcept
+		:m_storage()
+		,m_ops()
+		{
+			if(other.m_ops) {
+				other.m_ops->move(other.m_storage, m_storage);
+				m_ops = std::exchange(other.m_ops, nullptr);
+			}
+		}
+		~CaseHolder()
+		{
+			clear();
+		}
+		CaseHolder		&operator=(const CaseHolder &other)
+		{
+			if(this != &other) {
+				CaseHolder		tmp(other);
+				*this = std::move(tmp);
+			}
+			return	*this;
+		}
+		CaseHolder		&operator=(CaseHolder &&other) noexcept
+		{
+			if(this != &other) {
+				clear();
+				if(other.m_ops) {
+					other.m_ops->move(other.m_storage, m_storage);
+					m_ops = std::exchange(other.m_ops, nullptr);
+				}
+			}
+			return	*this;
+		}
+		template <typename T, typename=std::enable_if_t<!std::is_same<std::decay_t<T>, CaseHolder>::value>>
+		CaseHolder		&operator=(T &&val)
+		{
+			clear();
+			emplace<std::decay_t<T>>(std::forward<T>(val));
+			return	*this;
+		}
+		template <typename T, typename... Args>
+		void			emplace(Args&&... args)
+		{
+			clear();
+			emplaceImpl<T>(IsInline<T>{}, std::forward<Args>(args)...);
+			m_ops = operationsFor<T>();
+		}
+		bool			empty(void) const noexcept
+		{
+			return	!m_ops;
+		}
+		void			clear(void) noexcept
+		{
+			if(m_ops) {
+				m_ops->destroy(m_storage);
+				m_ops = nullptr;
+			}
+		}
+		//! Type of the stored object. typeid(void) if empty.
+		const std::type_info	&type(void) const noexcept
+		{
+			return	m_ops ? m_ops->type() : typeid(void);
+		}
+		//! Pointer to the stored object, or nullptr if the type does not match.
+		template <typename T>
+		const T			*get(void) const noexcept
+		{
+			if(!m_ops || ((m_ops != operationsFor<T>()) && (m_ops->type() != typeid(T)))) {
+				return	nullptr;
+			}
+			return	static_cast<const T *>(m_ops->get(m_storage));
+		}
+	private:
+		template <typename T, typename... Args>
+		void			emplaceImpl(std::true_type, Args&&... args)
+		{
+			new(&m_storage.buffer) T(std::forward<Args>(args)...);
+		}
+		template <typename T, typename... Args>
+		void			emplaceImpl(std::false_type, Args&&... args)
+		{
+			m_storage.ptr = new T(std::forward<Args>(args)...);
+		}
+}; // class CaseHolder
+
+//! Get pointer to the test case, or nullptr if the type does not match.
+template <typename T>
+const T			*case_cast(const CaseHolder *holder) noexcept
+{
+	return	holder ? holder->get<std::remove_cv_t<std::remove_reference_t<T>>>() : nullptr;
+}
+
+//! Get the test case. Throws bad_case_cast if the type does not match.
+/*!
+ * ns_any::any_cast と同様に使える。
+ */
+template <typename T>
+T				case_cast(const CaseHolder &holder)
+{
+	auto			p = case_cast<T>(&holder);
+	if(!p) {
+		throw	bad_case_cast();
+	}
+	return	*p;
+}
+
+//! Test case with the time taken to check it.
+struct	TimedCase {
+	//! テストケース。コピーできない型の場合は空。
+	CaseHolder		testCase;
+	std::chrono::nanoseconds	elapsed;
+}; // struct TimedCase
+
+//! Time measured for an input size.
+struct	SizeTiming {
+	size_t			size;
+	std::chrono::nanoseconds	elapsed;
+}; // struct SizeTiming
+
+//! Result of empirical complexity measurement.
+struct	ComplexityReport {
+	//! 最もよく当てはまった計算量("O(n log n)"等)。計測していなければ空。
+	std::string		bestFit;
+	//! 当てはまりの悪さ(時間に対する相対残差の二乗平均平方根)。
+	double			rms;
+	//! 計測した入力の大きさと時間。
+	std::vector<SizeTiming>	series;
+	ComplexityReport()
+	:bestFit()
+	,rms()
+	,series()
+	{}
+}; // struct ComplexityReport
+
+//! Performance counter values.
+/*!
+ * 計測できなかったイベントは has() が false になる。
+ */
+struct	PerfCounts {
+	enum	Event {
+		Instructions,
+		Cycles,
+		CacheMisses,
+		BranchMisses,
+		//! タスクの実行時間(ナノ秒)。
+		TaskClock,
+		PageFaults,
+		EventCount
+	};
+	//! 計測できたイベントのビット集合。
+	unsigned		valid;
+	uint64_t		values[EventCount];
+	PerfCounts()
+	:valid()
+	,values()
+	{}
+	bool			has(Event e) const
+	{
+		return	(valid >> e) & 1u;
+	}
+	uint64_t		get(Event e) const
+	{
+		return	values[e];
+	}
+	void			set(Event e, uint64_t val)
+	{
+		valid |= (1u << e);
+		values[e] = val;
+	}
+	bool			empty(void) const
+	{
+		return	!valid;
+	}
+	PerfCounts		&operator+=(const PerfCounts &other)
+	{
+		valid |= other.valid;
+		for(size_t i = 0; i < EventCount; ++i) {
+			values[i] += other.values[i];
+		}
+		return	*this;
+	}
+	//! Name of the event, such as "cache_misses".
+	static const char	*name(Event e)
+	{
+		static const char	*const names[EventCount] = {
+			"instructions", "cycles", "cache_misses", "branch_misses", "task_clock_ns", "page_faults",
+		};
+		return	names[e];
+	}
+}; // struct PerfCounts
+
 //! Test result for all checked cases.
 /*!
  * テストの結果を、テスト自体とは独立して保持するためのクラス。
@@ -159,13 +480,23 @@ struct	TestResult {
 	//! 最後のテストで用いられたテストケースについての説明。
 	std::string		lastCaseDescription;
 	//! 最後に失敗したテストケース。
-	ns_any::any		failedCase;
+	CaseHolder		failedCase;
 	//! テスト失敗の原因についての説明。
 	ns_optional::optional<std::string>	reason;
 	//! passの回数。
 	size_t			passCount;
 	//! skipの回数。
 	size_t			skipCount;
+	//! 重複を除いたテストケースの数。 case_gen::Unique 等、数えられる生成器を使った場合のみ0でない。
+	size_t			distinctCount;
+	//! テストの実行にかかった時間。
+	std::chrono::nanoseconds	elapsed;
+	//! 時間のかかったテストケース(遅い順)。 SimpleTest::recordSlowest() で有効になる。
+	std::vector<TimedCase>	slowestCases;
+	//! 計算量の計測結果。 ComplexityTest で設定される。
+	ComplexityReport	complexity;
+	//! 性質の検査中のパフォーマンスカウンタの合計。 SimpleTest::countPerfEvents() で有効になる。
+	PerfCounts		counters;
 	//TestResult() = default;
 	TestResult()
 	:abstract()
@@ -174,8 +505,13 @@ struct	TestResult {
 	,reason()
 	,passCount()
 	,skipCount()
+	,distinctCount()
+	,elapsed()
+	,slowestCases()
+	,complexity()
+	,counters()
 	{}
-	bool			isTestFailed(void) {
+	bool			isTestFailed(void) const {
 		return	!failedCase.empty();
 	}
 	// 失敗したテストについての情報のみをリセットする。
@@ -190,6 +526,11 @@ struct	TestResult {
 		reason = PROTEST_NULLOPT;
 		passCount = 0;
 		skipCount = 0;
+		distinctCount = 0;
+		elapsed = std::chrono::nanoseconds::zero();
+		slowestCases.clear();
+		complexity = ComplexityReport();
+		counters = PerfCounts();
 	}
 }; // struct TestResult
 
@@ -212,69 +553,57 @@ struct	SequentialTestResult {
 //! Print test result.
 void			printResult(std::ostream &, const TestResult &);
 
+//! Stream which stands for "no output".
+/*!
+ * 出力先を省略可能な引数のデフォルト値として使う。
+ * 書き込んでも何も起きない。
+ * ストリームの書式(幅など)は書き込みで変わるので、スレッドごとに別のオブジェクトを返す。
+ */
+std::ostream	&nullOstream(void);
+
+//! Check whether the stream is not nullOstream() (of any thread).
+bool			isOstreamAvailable(const std::ostream &ost);
+
 namespace	detail {
-	template <typename Tuple, size_t currentIndex, typename F>
-	auto			passAsNthTypeImpl(F &f, const ns_any::any &obj, size_t targetIndex)
-		-> std::enable_if_t<
-			(
-				!(currentIndex < std::tuple_size<Tuple>{}-1)
-				&& !std::is_void<std::result_of_t<F(std::tuple_element_t<currentIndex, Tuple>)>>{}
-			)
-			, ns_any::any>
+	//! Call f with the test case cast to T, and return the result as ns_any::any.
+	template <typename F, typename T>
+	auto			callWithCase(F &f, const CaseHolder &obj)
+		-> std::enable_if_t<!std::is_void<std::result_of_t<F(T)>>{}, ns_any::any>
 	{
-		return	f(ns_any::any_cast<std::tuple_element_t<currentIndex, Tuple>>());
+		return	f(case_cast<T>(obj));
 	}
-	template <typename Tuple, size_t currentIndex, typename F>
-	auto			passAsNthTypeImpl(F &f, const ns_any::any &obj, size_t targetIndex)
-		-> std::enable_if_t<
-			(
-				!(currentIndex < std::tuple_size<Tuple>{}-1)
-				&& std::is_void<std::result_of_t<F(std::tuple_element_t<currentIndex, Tuple>)>>{}
-			)
-			, ns_any::any>
+	template <typename F, typename T>
+	auto			callWithCase(F &f, const CaseHolder &obj)
+		-> std::enable_if_t<std::is_void<std::result_of_t<F(T)>>{}, ns_any::any>
 	{
-		f(ns_any::any_cast<std::tuple_element_t<currentIndex, Tuple>>(obj));
+		f(case_cast<T>(obj));
 		return	{};
 	}
-	template <typename Tuple, size_t currentIndex, typename F>
-	auto			passAsNthTypeImpl(F &f, const ns_any::any &obj, size_t targetIndex)
-		-> std::enable_if_t<
-			(
-				(currentIndex < std::tuple_size<Tuple>{}-1)
-				&& !std::is_void<std::result_of_t<F(std::tuple_element_t<currentIndex, Tuple>)>>{}
-			)
-			, ns_any::any>
-	{
-		if(currentIndex == targetIndex) {
-			return	f(ns_any::any_cast<std::tuple_element_t<currentIndex, Tuple>>());
-		} else {
-			return	passAsNthTypeImpl<Tuple, currentIndex+1>(f, obj, targetIndex);
-		}
-	}
-	template <typename Tuple, size_t currentIndex, typename F>
-	auto			passAsNthTypeImpl(F &f, const ns_any::any &obj, size_t targetIndex)
-		-> std::enable_if_t<
-			(
-				(currentIndex < std::tuple_size<Tuple>{}-1)
-				&& std::is_void<std::result_of_t<F(std::tuple_element_t<currentIndex, Tuple>)>>{}
-			)
-			, ns_any::any>
+
+	// 型ごとの呼び出しを関数ポインタの表にしておき、添字で直接選ぶ。
+	// 再帰による実体化がないので、型の数が多くてもコンパイルが深くならず、実行時も定数時間で選べる。
+	template <typename Tuple, typename F, size_t... Is>
+	ns_any::any		passAsNthTypeImpl(F &f, const CaseHolder &obj, size_t index, std::index_sequence<Is...>)
 	{
-		if(currentIndex == targetIndex) {
-			f(ns_any::any_cast<std::tuple_element_t<currentIndex, Tuple>>(obj));
-			return	{};
-		} else {
-			return	passAsNthTypeImpl<Tuple, currentIndex+1>(f, obj, targetIndex);
+		using	Caller = ns_any::any (*)(F &, const CaseHolder &);
+		static constexpr Caller	table[] = {&callWithCase<F, std::tuple_element_t<Is, Tuple>>...};
+		if(index >= sizeof...(Is)) {
+			throw	std::out_of_range("protest::passAsNthType: index out of range");
 		}
+		return	table[index](f, obj);
 	}
-}
+} // namespace detail
 
 //! Print test case for sequential test.
+/*!
+ * index 番目の型で obj の中身を取り出して f に渡す。
+ * index が型の数以上の場合は std::out_of_range を投げる。
+ */
 // FIXME: Should `obj' be const reference? Is there any problem if it is non-const reference?
 template <typename Tuple, typename F>
-ns_any::any		passAsNthType(F &&f, const ns_any::any &obj, size_t index)
+ns_any::any		passAsNthType(F &&f, const CaseHolder &obj, size_t index)
 {
-	return	detail::passAsNthTypeImpl<Tuple, 0>(f, obj, index);
+	return	detail::passAsNthTypeImpl<Tuple>(f, obj, index, std::make_index_sequence<std::tuple_size<Tuple>::value>());
 }
 
 //! Test result for a single test case.
@@ -300,15 +629,60 @@ struct	CheckResult {
 	}
 }; // struct CheckResult
 
+//! View of a contiguous sequence, for batch properties (std::span is not available in C++14).
+template <typename T>
+class	Span {
+	public:
+		using	element_type = T;
+		using	value_type = std::remove_cv_t<T>;
+		using	iterator = T *;
+	private:
+		T				*m_data;
+		size_t			m_size;
+	public:
+		Span()
+		:m_data(nullptr)
+		,m_size(0)
+		{}
+		Span(T *data, size_t size)
+		:m_data(data)
+		,m_size(size)
+		{}
+		//! Span<const T> from Span<T>.
+		template <typename U, typename=std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value>>
+		Span(const Span<U> &other)
+		:m_data(other.data())
+		,m_size(other.size())
+		{}
+		T				*data(void) const {
+			return	m_data;
+		}
+		size_t			size(void) const {
+			return	m_size;
+		}
+		bool			empty(void) const {
+			return	m_size == 0;
+		}
+		T				&operator[](size_t i) const {
+			return	m_data[i];
+		}
+		iterator		begin(void) const {
+			return	m_data;
+		}
+		iterator		end(void) const {
+			return	m_data + m_size;
+		}
+}; // class Span
+
 
 namespace	detail {
 	template <typename F, typename=void>
 	struct	is_callable_impl : std::false_type {};
 #if	defined(__cpp_lib_result_of_sfinae) && __cpp_lib_result_of_sfinae
-	// TODO: untested.
-	//       std::result_of がSFINAEに使えるようになったら確かめること。
+	// 第2引数を void にそろえる。 std::result_of_t<F> をそのまま使うと、
+	// 戻り値が void の場合しか部分特殊化に一致しない。
 	template <typename F>
-	struct	is_callable_impl<F, std::result_of_t<F>> : std::true_type {};
+	struct	is_callable_impl<F, std::conditional_t<true, void, std::result_of_t<F>>> : std::true_type {};
 #else
 	template <typename F>
 	struct	is_callable_impl<F,
@@ -410,6 +784,21 @@ using	UnsignedIntegers = std::tuple<uint8_t, uint16_t, uint32_t
 //! Floating-point number types for all size.
 using	Floats = std::tuple<float, double, long double>;
 
+//! Expand the macro for each type of Integers and Floats.
+/*!
+ * libprotest に明示的実体化を置く型の一覧。 extern template の宣言と、その定義(instantiations.cpp)で使う。
+ * Integers, Floats を変更した場合は、こちらも合わせること。
+ */
+#define	PROTEST_FOR_EACH_ARITHMETIC_TYPE(X) \
+	X(int8_t) X(uint8_t) X(int16_t) X(uint16_t) X(int32_t) X(uint32_t) \
+	PROTEST_FOR_EACH_INT64_TYPE_(X) \
+	X(float) X(double) X(long double)
+#if	defined(INT64_MAX) && defined(UINT64_MAX)
+#	define	PROTEST_FOR_EACH_INT64_TYPE_(X)	X(int64_t) X(uint64_t)
+#else
+#	define	PROTEST_FOR_EACH_INT64_TYPE_(X)
+#endif
+
 } // namespace protest
 } // namespace nu11p0
 #endif	// ifndef INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
@@ -0,0 +1,109 @@
+/*!
+ * \file   reporter.hpp
+ * \brief  Machine-readable output of test results.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__REPORTER_HPP_
+#define	INCLUDED__NU11P0__PROTEST__REPORTER_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+namespace	nu11p0 {
+namespace	protest {
+
+//! Receiver of test results.
+/*!
+ * 結果はテストが終わるたびに report() で渡され、その場で出力される。
+ * よって、テスト中にプロセスが異常終了しても、それまでに終わったテストの結果は残る。
+ */
+class	Reporter {
+	public:
+		virtual			~Reporter();
+		//! Called once before the first result.
+		virtual void	begin(void);
+		//! Called each time a test finishes.
+		virtual void	report(const TestResult &result) = 0;
+		//! Called once after the last result.
+		virtual void	end(void);
+		//! Adapter to pass the reporter as `printer' of generic::test().
+		/*!
+		 * generic::test() に渡されるストリームは使わず、レポーター自身の出力先に書く。
+		 */
+		std::function<void(std::ostream &, const TestResult &)>	printer(void);
+}; // class Reporter
+
+//! Colored text, same as printResult().
+class	TextReporter : public Reporter {
+	private:
+		std::ostream	&m_ost;
+	public:
+		explicit		TextReporter(std::ostream &ost);
+		void			report(const TestResult &result) override;
+}; // class TextReporter
+
+//! One JSON object per line, for each result.
+/*!
+ * 出力例:
+ * {"abstract":"...","case":"random case","status":"pass","pass":20,"skip":0,"elapsed_ns":12345}
+ * 失敗した場合は "status":"fail" となり、 "reason" が加わる。
+ * 計算量を計測していれば "complexity" と、 [大きさ, ナノ秒] の配列 "complexity_series" が加わる。
+ * パフォーマンスカウンタを計測していれば、その値が "counters" にオブジェクトで加わる。
+ * 遅いケースを記録していれば、その時間が "slowest_ns" に配列で加わる。
+ */
+class	JsonLinesReporter : public Reporter {
+	private:
+		std::ostream	&m_ost;
+		//! 一件分の出力を組み立てるバッファ。容量は使い回す。
+		std::string		m_buffer;
+	public:
+		explicit		JsonLinesReporter(std::ostream &ost);
+		void			report(const TestResult &result) override;
+}; // class JsonLinesReporter
+
+//! JUnit XML.
+/*!
+ * 各結果はtestcase要素として逐次書き出される。
+ * 閉じタグは end() で書くので、途中で異常終了した場合はXMLとして閉じていない出力になる。
+ * パフォーマンスカウンタを計測していれば、testcase要素のpropertiesとして書く。
+ *
+ * testsuite要素の開始タグは最初に書くので、件数は属性にできない。
+ * 代わりに end() で testsuite要素の末尾に properties として tests, failures, errors を書く。
+ * 例外も失敗として報告されるので、 errors は常に0。
+ */
+class	JUnitXmlReporter : public Reporter {
+	private:
+		std::ostream	&m_ost;
+		std::string		m_buffer;
+		std::string		m_suiteName;
+		size_t			m_tests;
+		size_t			m_failures;
+	public:
+		explicit		JUnitXmlReporter(std::ostream &ost, std::string suiteName="protest");
+		void			begin(void) override;
+		void			report(const TestResult &result) override;
+		void			end(void) override;
+}; // class JUnitXmlReporter
+
+namespace	detail {
+	//! Append decimal representation of the value.
+	void			appendDecimal(std::string &buf, uint64_t val);
+	//! Append nanoseconds as seconds with 9 fractional digits.
+	void			appendSeconds(std::string &buf, std::chrono::nanoseconds ns);
+	//! Append the string as a quoted JSON string.
+	void			appendJsonString(std::string &buf, const std::string &str);
+	//! Append the string escaped for XML attribute values.
+	void			appendXmlEscaped(std::string &buf, const std::string &str);
+} // namespace detail
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__REPORTER_HPP_
@@ -0,0 +1,214 @@
+/*!
+ * \file   runner.hpp
+ * \brief  Test registry and runner.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__RUNNER_HPP_
+#define	INCLUDED__NU11P0__PROTEST__RUNNER_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace	nu11p0 {
+namespace	protest {
+
+class	Reporter;
+
+//! Context passed to registered tests.
+/*!
+ * 登録されたテストは、 out() に進捗を出力し、 runTest() 等の結果を report() で報告する。
+ * 報告された結果は printResult() で out() に出力され、レポーターにも渡される。
+ */
+class	TestContext {
+	private:
+		std::ostream	&m_ost;
+		Reporter		*m_reporter;
+		size_t			m_resultCount;
+		size_t			m_failureCount;
+		size_t			m_caseCount;
+		uint64_t		m_seed;
+	public:
+		/*!
+		 * \param ost       Output for progress and results. nullOstream() to suppress.
+		 * \param reporter  Reporter to receive results. May be nullptr.
+		 * シードは std::random_device で決める。
+		 */
+		TestContext(std::ostream &ost, Reporter *reporter);
+		//! \param seed  Seed returned by seed().
+		TestContext(std::ostream &ost, Reporter *reporter, uint64_t seed);
+		TestContext(const TestContext &) = delete;
+		TestContext		&operator=(const TestContext &) = delete;
+		//! Stream to pass to runTest() and generic::test().
+		std::ostream	&out(void);
+		void			report(const TestResult &result);
+		void			report(const SequentialTestResult &result);
+		//! Adapter to pass as `printer' of generic::test().
+		std::function<void(std::ostream &, const TestResult &)>	printer(void);
+		size_t			resultCount(void) const;
+		size_t			failureCount(void) const;
+		//! Sum of pass and skip counts of the reported results.
+		size_t			caseCount(void) const;
+		bool			failed(void) const;
+		//! Seed for the random generators of this run of the test.
+		/*!
+		 * `protest::case_gen::Random<T>(ctx.seed())' のように生成器に渡すと、
+		 * --seed で同じケースを再現でき、ソークモードでは実行ごとに異なるケースを試せる。
+		 */
+		uint64_t		seed(void) const;
+}; // class TestContext
+
+//! Function of a registered test.
+using	TestFunction = std::function<void(TestContext &)>;
+
+//! Registered test.
+struct	TestInfo {
+	//! テストの名前。フィルタの対象になる。
+	std::string		name;
+	TestFunction	fun;
+	//! 実行にかかる時間の見込み。 --jobs で並列に実行する場合、長いものから先に始める。0なら不明。
+	std::chrono::nanoseconds	expectedDuration;
+}; // struct TestInfo
+
+//! Collection of tests.
+class	TestRegistry {
+	private:
+		std::vector<TestInfo>	m_tests;
+	public:
+		TestRegistry();
+		//! Registry used by Registration and runMain().
+		static TestRegistry	&global(void);
+		void			add(std::string name, TestFunction fun, std::chrono::nanoseconds expectedDuration=std::chrono::nanoseconds::zero());
+		//! Tests in registration order.
+		const std::vector<TestInfo>	&tests(void) const;
+}; // class TestRegistry
+
+//! Register a test to TestRegistry::global() at static initialization.
+/*!
+ * 使用例:
+ *     static protest::Registration	reg("absolute/int64/positive", [](protest::TestContext &ctx) {
+ *         protest::SimpleTest<int64_t>	test(...);
+ *         ctx.report(test.runTest("random case", protest::case_gen::Random<int64_t>(), 1000, ctx.out()));
+ *     });
+ */
+class	Registration {
+	public:
+		Registration(std::string name, TestFunction fun, std::chrono::nanoseconds expectedDuration=std::chrono::nanoseconds::zero());
+}; // class Registration
+
+//! Options for the runner.
+struct	RunnerOptions {
+	//! グロブパターン(*, ?)。先頭が'-'のものは除外パターン。
+	std::vector<std::string>	filters;
+	//! テストを実行せず、名前を一覧表示する。
+	bool			listOnly;
+	size_t			shardIndex;
+	size_t			shardCount;
+	//! "text", "jsonl" or "junit".
+	std::string		format;
+	//! Output file for jsonl/junit. Standard output if empty.
+	std::string		output;
+	//! 同時に実行するテストの数。0ならハードウェアのスレッド数。
+	size_t			jobs;
+	//! 前回までの結果を記録するファイル。空なら記録しない。
+	std::string		history;
+	//! 最初に失敗したテストで止める。
+	bool			failFast;
+	//! --help が指定された。
+	bool			showHelp;
+	//! TestContext::seed() の値。指定しなければテストごとに乱数で決める(ソークモードでは基準のシード)。
+	ns_optional::optional<uint64_t>	seed;
+	//! テストを止めるまで繰り返し実行する(runSoak())。
+	bool			soak;
+	//! ソークモードで全てのテストを実行する回数。0なら止めるまで。
+	size_t			soakRounds;
+	//! ソークモードで失敗した結果を保存するディレクトリ。空なら保存しない。
+	std::string		soakCorpus;
+	//! ソークモードの統計を Prometheus のテキスト形式で書き出すファイル。空なら書かない。
+	std::string		metricsFile;
+	//! ソークモードの統計を接続ごとに返す Unix ドメインソケットのパス。空なら待ち受けない。
+	std::string		metricsSocket;
+	//! metricsFile を書き直す間隔。
+	std::chrono::seconds	metricsInterval;
+	RunnerOptions()
+	:filters()
+	,listOnly(false)
+	,shardIndex(0)
+	,shardCount(1)
+	,format("text")
+	,output()
+	,jobs(1)
+	,history()
+	,failFast(false)
+	,showHelp(false)
+	,seed()
+	,soak(false)
+	,soakRounds(0)
+	,soakCorpus()
+	,metricsFile()
+	,metricsSocket()
+	,metricsInterval(10)
+	{}
+}; // struct RunnerOptions
+
+//! Parse command line options.
+/*!
+ * --filter=PATTERN (複数指定可、','区切りも可), --list,
+ * --shard-index=N, --shard-count=M, --format=text|jsonl|junit, --output=FILE, --jobs=N,
+ * --history=FILE, --fail-fast, --seed=N, --soak, --soak-rounds=N, --soak-corpus=DIR,
+ * --metrics-file=FILE, --metrics-socket=PATH, --metrics-interval=SECONDS, --help を受け付ける。
+ * シャードは環境変数 PROTEST_SHARD_INDEX, PROTEST_SHARD_COUNT でも指定できる(コマンドラインが優先)。
+ * 環境変数の不正な値もエラーになる。空の値は指定しないのと同じ。
+ * \return false if failed (message is written to err), or --help is given (usage is written to err).
+ */
+bool			parseRunnerOptions(int argc, char **argv, RunnerOptions &opts, std::ostream &err);
+
+//! Match the name with glob pattern (`*' and `?').
+bool			globMatch(const std::string &pattern, const std::string &name);
+
+//! Tests to run: filtered, then sharded.
+/*!
+ * シャードはフィルタ後の一覧に対して、登録順の番号を shardCount で割った余りで決まる。
+ */
+std::vector<const TestInfo *>	selectTests(const TestRegistry &registry, const RunnerOptions &opts);
+
+//! Run (or list) the selected tests.
+/*!
+ * jobs が2以上なら、テストをワークスティーリングのスレッドプールで並列に実行する。
+ * 各テストの出力と報告はテストごとにバッファし、成功したテストは登録順に書き出す。
+ * 失敗したテストは、早く気付けるように終わり次第書き出す。
+ * 並列に実行するテストは、互いに共有する状態を持たないこと。
+ * history を指定した場合は、前回までに失敗したテストと実行時間の短いテストから実行し(TestHistory::schedule())、
+ * 結果を記録する。この場合も同じくバッファし、成功したテストは登録順に並べ直す。
+ * failFast を指定した場合は、最初に失敗したテストで止め、残りは実行しない。
+ * soak を指定した場合は runSoak() に任せる。
+ * \return 0 if all passed, 1 if any failed.
+ */
+int				runTests(const TestRegistry &registry, const RunnerOptions &opts, std::ostream &ost);
+
+namespace	detail {
+	//! 64-bit seed from std::random_device.
+	uint64_t		randomSeed(void);
+	//! Run a test, and report an uncaught exception as a failure.
+	void			runTestCatching(const TestInfo &test, TestContext &ctx);
+} // namespace detail
+
+//! Entry point for suites linked with libprotest_main.
+/*!
+ * ソークモードでは、 SIGINT と SIGTERM で requestSoakStop() を呼び、実行中のテストが終わってから止める。
+ */
+int				runMain(int argc, char **argv);
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__RUNNER_HPP_
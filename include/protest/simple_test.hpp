@@ -13,35 +13,211 @@
 #	include <protest/protest_common.hpp>
 #endif
 #include <protest/test_base.hpp>
+#ifndef	INCLUDED__NU11P0__PROTEST__ARENA_HPP_
+#	include <protest/arena.hpp>
+#endif
+#ifndef	INCLUDED__NU11P0__PROTEST__WATCHDOG_HPP_
+#	include <protest/watchdog.hpp>
+#endif
+#ifndef	INCLUDED__NU11P0__PROTEST__PERF_COUNTER_HPP_
+#	include <protest/perf_counter.hpp>
+#endif
+#ifndef	INCLUDED__NU11P0__PROTEST__CHECKPOINT_HPP_
+#	include <protest/checkpoint.hpp>
+#endif
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
 #include <functional>
-#include <iosfwd>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
 
 namespace	nu11p0 {
 namespace	protest {
 
+namespace	detail {
+	//! Copy the test case into CaseHolder, if it is copy constructible.
+	template <typename T>
+	auto			copyCase(const T &val)
+		-> std::enable_if_t<std::is_copy_constructible<T>{}, CaseHolder>
+	{
+		return	CaseHolder(val);
+	}
+	template <typename T>
+	auto			copyCase(const T &)
+		-> std::enable_if_t<!std::is_copy_constructible<T>{}, CaseHolder>
+	{
+		return	CaseHolder();
+	}
+	//! Property over a batch of cases: `void(Span<const T> cases, Span<uint8_t> failed)'.
+	template <typename T>
+	using	BatchFunction = std::function<void(Span<const T>, Span<uint8_t>)>;
+	//! True if F is a batch property for cases of type T.
+	template <typename F, typename T>
+	using	IsBatchProperty = is_callable<std::decay_t<F> &, Span<const T>, Span<uint8_t>>;
+	// SimpleTest のコンストラクタは性質を両方に渡すが、実際に受け取る(ムーブする)のは一方だけである。
+	template <typename T, typename F>
+	auto			caseProperty(F &&f)
+		-> std::enable_if_t<!IsBatchProperty<F, T>::value, std::function<CheckResult(const T &)>>
+	{
+		return	std::forward<F>(f);
+	}
+	template <typename T, typename F>
+	auto			caseProperty(F &&)
+		-> std::enable_if_t<IsBatchProperty<F, T>::value, std::function<CheckResult(const T &)>>
+	{
+		return	nullptr;
+	}
+	template <typename T, typename F>
+	auto			batchProperty(F &&f)
+		-> std::enable_if_t<IsBatchProperty<F, T>::value, BatchFunction<T>>
+	{
+		return	std::forward<F>(f);
+	}
+	template <typename T, typename F>
+	auto			batchProperty(F &&)
+		-> std::enable_if_t<!IsBatchProperty<F, T>::value, BatchFunction<T>>
+	{
+		return	nullptr;
+	}
+} // namespace detail
+
+//! Test which checks a property for generated cases.
+/*!
+ * 性質は次のどちらかの形の関数。
+ * - `CheckResult(const T &)': ケースを一つずつ検査する。
+ * - `void(Span<const T> cases, Span<uint8_t> failed)': バッチ性質。
+ *   batchSize() 個(既定では1024個)のケースをまとめて受け取り、失敗したケースに対応する failed の要素を0以外にする。
+ *   failed は0で初期化されている。最初に失敗したケースが failedCase になる。
+ *   数値関数等をケースの配列に対してベクトル化して実行でき、ケースごとの関数呼び出しの費用がかからない。
+ *   バッチ性質では timeout() と recordSlowest() は使われない。
+ */
 template <typename T>
 class	SimpleTest {
 	public:
 		using	param_type = T;
+		//! slowCaseFactor() の中央値を求める、直近のケースの数。
+		static constexpr size_t	caseTimeWindow = 1024;
+		//! slowCaseFactor() で調べ始めるまでのケースの数。
+		static constexpr size_t	minCaseTimes = 32;
+		//! slowCaseFactor() の中央値を求め直す間隔(ケースの数)。
+		static constexpr size_t	medianInterval = 64;
 	private:
+		using	function_type = std::function<CheckResult(const param_type &)>;
+		//! Watchdog のスレッドで一つのケースを検査する。
+		/*!
+		 * タイムアウトした場合はスレッドと一緒に放棄されるので、性質とケースは自身で保持する。
+		 */
+		struct	CaseJob : public WatchdogJob {
+			std::shared_ptr<const function_type>	fun;
+			//! ケースが確保されたアリーナ。放棄されても、ケースが破棄されるまで生存させる。
+			std::shared_ptr<Arena>	arena;
+			ns_optional::optional<param_type>	param;
+			CheckResult		result;
+			std::exception_ptr	error;
+			void			run(void) override
+			{
+				try {
+					result = (*fun)(param.value());
+				} catch(...) {
+					error = std::current_exception();
+				}
+			}
+		};
 		TestResult			m_result;
-		std::function<CheckResult(const param_type &)>	m_fun;
+		function_type		m_fun;
 		std::function<bool(const param_type &)>	m_preCondition;
+		//! テストケース用のアリーナ。runTest()ごとにリセットされる。
+		std::shared_ptr<Arena>	m_arena;
+		//! ケースごとの制限時間。0なら制限しない。
+		std::chrono::nanoseconds	m_timeout;
+		//! 記録する遅いケースの数。
+		size_t			m_slowestCount;
+		//! 中央値のこの倍数より時間のかかったケースを失敗とする。0なら調べない。
+		double			m_slowFactor;
+		//! 直近のケースの時間。中央値を求めるのに使う。
+		std::vector<std::chrono::nanoseconds>	m_caseTimes;
+		size_t			m_caseTimesNext;
+		//! 最後に求めた中央値と、その後に加えた時間の数。
+		std::chrono::nanoseconds	m_medianTime;
+		size_t			m_sinceMedian;
+		//! 中央値を求めるための作業領域。
+		std::vector<std::chrono::nanoseconds>	m_sortedTimes;
+		std::unique_ptr<Watchdog>	m_watchdog;
+		//! Watchdog のスレッドから使う m_fun の複製。
+		std::shared_ptr<const function_type>	m_sharedFun;
+		//! 使い回すジョブ。タイムアウトしたら作り直す。
+		std::shared_ptr<CaseJob>	m_job;
+		//! 性質の検査中のパフォーマンスカウンタ。 countPerfEvents() で作られる。
+		std::unique_ptr<PerfCounterGroup>	m_perf;
+		//! チェックポイントのファイル。空なら保存しない。
+		std::string		m_checkpointPath;
+		std::chrono::nanoseconds	m_checkpointInterval;
+		//! runTest() の開始時にチェックポイントから再開する。
+		bool			m_resume;
+		//! バッチ性質。空でなければ m_fun の代わりに使う。
+		detail::BatchFunction<param_type>	m_batchFun;
+		size_t			m_batchSize;
+		//! バッチのケースと失敗の印。次のバッチで再利用する。
+		std::vector<param_type>	m_batch;
+		std::vector<uint8_t>	m_failedLanes;
 	public:
 		template <typename F>
 		SimpleTest(std::string &&a, F &&f)
 		:m_result()
-		,m_fun(std::forward<F>(f))
+		,m_fun(detail::caseProperty<param_type>(std::forward<F>(f)))
 		,m_preCondition()
+		,m_arena()
+		,m_timeout()
+		,m_slowestCount()
+		,m_slowFactor()
+		,m_caseTimes()
+		,m_caseTimesNext()
+		,m_medianTime()
+		,m_sinceMedian()
+		,m_sortedTimes()
+		,m_watchdog()
+		,m_sharedFun()
+		,m_job()
+		,m_perf()
+		,m_checkpointPath()
+		,m_checkpointInterval()
+		,m_resume(false)
+		,m_batchFun(detail::batchProperty<param_type>(std::forward<F>(f)))
+		,m_batchSize(1024)
+		,m_batch()
+		,m_failedLanes()
 		{
 			m_result.abstract = std::forward<std::string>(a);
 		}
 		template <typename F, typename PreCon>
 		SimpleTest(std::string &&a, F &&f, PreCon &&precon)
 		:m_result()
-		,m_fun(std::forward<F>(f))
+		,m_fun(detail::caseProperty<param_type>(std::forward<F>(f)))
 		,m_preCondition(precon)
+		,m_arena()
+		,m_timeout()
+		,m_slowestCount()
+		,m_slowFactor()
+		,m_caseTimes()
+		,m_caseTimesNext()
+		,m_medianTime()
+		,m_sinceMedian()
+		,m_sortedTimes()
+		,m_watchdog()
+		,m_sharedFun()
+		,m_job()
+		,m_perf()
+		,m_checkpointPath()
+		,m_checkpointInterval()
+		,m_resume(false)
+		,m_batchFun(detail::batchProperty<param_type>(std::forward<F>(f)))
+		,m_batchSize(1024)
+		,m_batch()
+		,m_failedLanes()
 		{
 			m_result.abstract = std::forward<std::string>(a);
 		}
@@ -53,56 +229,218 @@ class	SimpleTest {
 		{
 			m_result.clearAll();
 		}
+		//! Arena for test cases, available to generators during runTest().
+		Arena			&arena(void)
+		{
+			if(!m_arena) {
+				m_arena = std::make_shared<Arena>();
+			}
+			return	*m_arena;
+		}
+		//! Fail a case which takes longer than the timeout. Zero disables.
+		/*!
+		 * 制限時間を設定すると、各ケースは Watchdog のスレッドで検査される。
+		 * 時間内に終わらなかったケースは reason に経過時間を書いて失敗とし、
+		 * そのスレッドは放棄して次のテストに進む(ケースのコピーが failedCase になる)。
+		 */
+		void			timeout(std::chrono::nanoseconds t)
+		{
+			m_timeout = t;
+		}
+		//! Count performance events during the checks, and sum them to TestResult::counters.
+		/*!
+		 * カウンタは性質の呼び出しの間だけ動かす(生成器や事前条件は含まない)。
+		 * カウンタはこれを呼んだスレッドのものなので、 runTest() も同じスレッドで呼ぶこと。
+		 * timeout() を設定している場合、性質は別スレッドで実行されるので計測されない。
+		 */
+		void			countPerfEvents(bool enable)
+		{
+			if(!enable) {
+				m_perf.reset();
+			} else if(!m_perf) {
+				m_perf.reset(new PerfCounterGroup());
+				m_perf->open();
+			}
+		}
+		//! Record the k slowest cases to TestResult::slowestCases. Zero disables.
+		void			recordSlowest(size_t k)
+		{
+			m_slowestCount = k;
+		}
+		//! Fail a case which takes more than factor times the median of the cases so far. Zero disables.
+		/*!
+		 * 中央値は runTest() ごとに、直近の caseTimeWindow 個のケースから求め直す。
+		 * 最初の minCaseTimes 個のケースは中央値を求めるためだけに使い、調べない。
+		 * 性質自体は成功していても、そのケースを failedCase として報告する。
+		 */
+		void			slowCaseFactor(double factor)
+		{
+			m_slowFactor = factor;
+		}
+		//! Save the progress of runTest() to the file periodically. Empty path disables.
+		/*!
+		 * 成功したケースの数と、生成器が対応していればその位置(saveState())を interval ごとに書き出す。
+		 * runTest() が戻るときにファイルは削除されるので、残っているのは実行が中断された場合だけである。
+		 */
+		void			checkpoint(std::string path, std::chrono::nanoseconds interval=std::chrono::seconds(60))
+		{
+			m_checkpointPath = std::move(path);
+			m_checkpointInterval = interval;
+		}
+		//! Continue runTest() from the checkpoint file, if it exists.
+		/*!
+		 * テストの説明とテストケースの説明が一致するチェックポイントのみ使う。
+		 * 生成器が loadState() に対応していなければ、数だけを引き継いで生成器は最初から使う。
+		 */
+		void			resume(bool enable)
+		{
+			m_resume = enable;
+		}
+		//! Number of cases given to a batch property at once.
+		void			batchSize(size_t n)
+		{
+			m_batchSize = std::max<size_t>(n, 1);
+		}
 		// maxCountはskipも含めての数。
 		template <typename TCG>
-		const TestResult	&runTest(std::string &&caseDescription, TCG &&testcaseGenerator, size_t maxCount, std::ostream &ost=*static_cast<std::ostream *>(nullptr))
+		const TestResult	&runTest(std::string &&caseDescription, TCG &&testcaseGenerator, size_t maxCount, std::ostream &ost=nullOstream())
 		{
-			bool			ostreamAvailable = std::addressof(ost);
+			bool			ostreamAvailable = isOstreamAvailable(ost);
 			if(m_result.isTestFailed()) {
 				// 以前のテストのエラー情報がクリアされていない。
 				return	m_result;
 			}
 			m_result.lastCaseDescription = std::forward<std::string>(caseDescription);
+			// 前回の実行のテストケースはもう参照されていない(失敗していればここまで来ない)ので、
+			// アリーナを再利用する。タイムアウトで放棄されたケースが使っていれば新しく作る。
+			if(m_job) {
+				m_job->arena.reset();
+			}
+			detail::bindArena(testcaseGenerator, detail::freshArena(m_arena));
 			size_t			count = 0;
 			auto			startTime = std::chrono::steady_clock::now();
 			auto			prevTime = startTime;
 			bool			progressPrinted = false;
 			bool			hasPreCondition = static_cast<bool>(m_preCondition);
+			const bool		hasTimeout = (m_timeout != std::chrono::nanoseconds::zero());
+			const bool		timed = hasTimeout || m_slowestCount || (m_slowFactor > 0);
+			m_caseTimes.clear();
+			m_caseTimesNext = 0;
+			m_medianTime = std::chrono::nanoseconds::zero();
+			m_sinceMedian = 0;
+			auto			*perf = hasTimeout ? nullptr : m_perf.get();
+			if(perf) {
+				perf->reset();
+			}
 			auto			&passCount = m_result.passCount;
 			auto			&skipCount = m_result.skipCount;
-			if(maxCount) {
-				while(auto &&c = testcaseGenerator()) {
-					auto			&&param = c.value();
-					if(hasPreCondition && !m_preCondition(param)) {
-						++skipCount;
-						continue;
-					}
-					if(auto &&res = checkCase(std::forward<param_type>(param))) {
-						break;
-					}
-					++passCount;
-					if(++count >= maxCount) {
-						break;
-					}
+			const bool		checkpointing = !m_checkpointPath.empty();
+			auto			lastCheckpoint = startTime;
+			if(checkpointing && m_resume) {
+				resumeFromCheckpoint(testcaseGenerator, count);
+			}
+			if(m_slowestCount) {
+				// 前回の実行の後に遅い順に並べ替えているので、ヒープに戻す。
+				std::make_heap(m_result.slowestCases.begin(), m_result.slowestCases.end(), slower);
+			}
+			if(maxCount && (count < maxCount)) {
 #include <protest/loligger_sgr_macro.h>
-					if(ostreamAvailable) {
-						auto			nowTime = std::chrono::steady_clock::now();
-						if((nowTime - prevTime) >= std::chrono::milliseconds(500)) {
-							prevTime = nowTime;
-							ost << '\r' << "[" SGR(FG_YELLOW) "RUN" SGR(RESET) " ] pass: " << passCount << ", skip: " << skipCount << std::flush;
-							progressPrinted = true;
+				// 成功したケース(バッチ)ごとに、チェックポイントの保存と経過の表示を行う。
+				const auto		afterPass = [&]() {
+						if(checkpointing) {
+							auto			nowTime = std::chrono::steady_clock::now();
+							if((nowTime - lastCheckpoint) >= m_checkpointInterval) {
+								lastCheckpoint = nowTime;
+								saveCheckpoint(testcaseGenerator, count, nowTime - startTime);
+							}
+						}
+						if(ostreamAvailable) {
+							auto			nowTime = std::chrono::steady_clock::now();
+							if((nowTime - prevTime) >= std::chrono::milliseconds(500)) {
+								prevTime = nowTime;
+								ost << '\r' << "[" SGR(FG_YELLOW) "RUN" SGR(RESET) " ] pass: " << passCount << ", skip: " << skipCount << std::flush;
+								progressPrinted = true;
+							}
+						}
+					};
+				if(m_batchFun) {
+					while(count < maxCount) {
+						const bool		exhausted = !fillBatch(testcaseGenerator, std::min(m_batchSize, maxCount - count));
+						if(m_batch.empty() || checkBatch(perf)) {
+							break;
 						}
+						const size_t	n = m_batch.size();
+						for(auto &param : m_batch) {
+							detail::recycleCase(testcaseGenerator, std::move(param));
+						}
+						m_batch.clear();
+						passCount += n;
+						count += n;
+						if(exhausted || (count >= maxCount)) {
+							break;
+						}
+						afterPass();
 					}
+				} else {
+					while(auto &&c = testcaseGenerator()) {
+						auto			&&param = c.value();
+						if(hasPreCondition && !m_preCondition(param)) {
+							++skipCount;
+							detail::recycleCase(testcaseGenerator, std::move(param));
+							continue;
+						}
+						auto			caseStartTime = timed ? std::chrono::steady_clock::now() : startTime;
+						if(hasTimeout) {
+							if(checkCaseWithTimeout(param)) {
+								break;
+							}
+						} else if(perf) {
+							PerfCounterScope	scope(perf);
+							if(checkCase(std::forward<param_type>(param))) {
+								break;
+							}
+						} else if(auto &&res = checkCase(std::forward<param_type>(param))) {
+							break;
+						}
+						if(timed) {
+							const auto		caseElapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - caseStartTime);
+							if(m_slowestCount) {
+								recordCaseTime(param, caseElapsed);
+							}
+							if((m_slowFactor > 0) && isSlowCase(param, caseElapsed)) {
+								break;
+							}
+						}
+						// 失敗しなかったケースは生成器に返して、バッファを再利用させる。
+						detail::recycleCase(testcaseGenerator, std::move(param));
+						++passCount;
+						if(++count >= maxCount) {
+							break;
+						}
+						afterPass();
+					}
+				}
+				auto			elapsed = std::chrono::steady_clock::now() - startTime;
+				m_result.elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+				detail::recordDistinctCount(testcaseGenerator, m_result);
+				if(perf) {
+					m_result.counters += perf->read();
+				}
+				if(m_slowestCount) {
+					std::sort_heap(m_result.slowestCases.begin(), m_result.slowestCases.end(), slower);
 				}
 				if(progressPrinted) {
 					ost << '\r'
 						<< "[" SGR(FG_GREEN) "DONE" SGR(RESET) "] elapsed: "
-						<< std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count()
+						<< std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()
 						<< "ms, pass: " << passCount << ", skip: " << skipCount << std::endl;
 				}
 #define	SGR_UNDEF
 #include <protest/loligger_sgr_macro.h>
 			}
+			if(checkpointing) {
+				detail::removeCheckpoint(m_checkpointPath);
+			}
 			return	m_result;
 		}
 		CheckResult		checkCase(param_type &&arg)
@@ -110,12 +448,186 @@ class	SimpleTest {
 			CheckResult		res = m_fun(arg);
 			if(res.isTestFailed()) {
 				m_result.failedCase = std::forward<param_type>(arg);
-				m_result.reason = res.reason.value();
+				m_result.reason = std::move(res.reason.value());
 			}
 			return	res;
 		}
+	private:
+		//! Fill m_batch with up to n cases which satisfy the precondition. Returns false if the generator ran out.
+		template <typename TCG>
+		bool			fillBatch(TCG &gen, size_t n)
+		{
+			m_batch.clear();
+			while(m_batch.size() < n) {
+				auto			&&c = gen();
+				if(!c) {
+					return	false;
+				}
+				auto			&&param = c.value();
+				if(m_preCondition && !m_preCondition(param)) {
+					++m_result.skipCount;
+					detail::recycleCase(gen, std::move(param));
+					continue;
+				}
+				m_batch.push_back(std::move(param));
+			}
+			return	true;
+		}
+		//! Check m_batch with the batch property. Returns true if a case failed.
+		/*!
+		 * 失敗したケースより前のケースは成功として数える。
+		 * テンプレートにしているのは、 std::vector<bool> の data() が無いため(明示的実体化で使われないように)。
+		 */
+		template <typename P=param_type>
+		bool			checkBatch(PerfCounterGroup *perf)
+		{
+			static_assert(!std::is_same<P, bool>::value, "batch properties do not support bool cases");
+			const size_t	n = m_batch.size();
+			m_failedLanes.assign(n, 0);
+			{
+				PerfCounterScope	scope(perf);
+				m_batchFun(Span<const P>(m_batch.data(), n), Span<uint8_t>(m_failedLanes.data(), n));
+			}
+			const auto		failed = std::find_if(m_failedLanes.begin(), m_failedLanes.end(), [](uint8_t x) { return x != 0; });
+			if(failed == m_failedLanes.end()) {
+				return	false;
+			}
+			const size_t	lane = static_cast<size_t>(failed - m_failedLanes.begin());
+			m_result.passCount += lane;
+			m_result.failedCase = std::move(m_batch[lane]);
+			m_result.reason.emplace("failed at lane " + std::to_string(lane) + " of a batch of " + std::to_string(n));
+			m_batch.clear();
+			return	true;
+		}
+		template <typename TCG>
+		void			saveCheckpoint(const TCG &gen, size_t count, std::chrono::steady_clock::duration runElapsed)
+		{
+			Checkpoint		cp;
+			cp.abstract = m_result.abstract;
+			cp.caseDescription = m_result.lastCaseDescription;
+			cp.count = count;
+			cp.passCount = m_result.passCount;
+			cp.skipCount = m_result.skipCount;
+			cp.elapsed = m_result.elapsed + std::chrono::duration_cast<std::chrono::nanoseconds>(runElapsed);
+			cp.hasGeneratorState = detail::saveGeneratorState(gen, cp.generatorState);
+			detail::writeCheckpoint(m_checkpointPath, cp);
+		}
+		template <typename TCG>
+		void			resumeFromCheckpoint(TCG &gen, size_t &count)
+		{
+			Checkpoint		cp;
+			if(!detail::readCheckpoint(m_checkpointPath, cp)
+					|| (cp.abstract != m_result.abstract) || (cp.caseDescription != m_result.lastCaseDescription)) {
+				return;
+			}
+			if(cp.hasGeneratorState) {
+				detail::loadGeneratorState(gen, cp.generatorState);
+			}
+			count = cp.count;
+			m_result.passCount = cp.passCount;
+			m_result.skipCount = cp.skipCount;
+			m_result.elapsed = cp.elapsed;
+		}
+		//! Check the case on the watchdog thread. Returns true if failed (or timed out).
+		bool			checkCaseWithTimeout(param_type &param)
+		{
+			if(!m_watchdog) {
+				m_watchdog.reset(new Watchdog());
+			}
+			if(!m_sharedFun) {
+				m_sharedFun = std::make_shared<const function_type>(m_fun);
+			}
+			if(!m_job) {
+				m_job = std::make_shared<CaseJob>();
+				m_job->fun = m_sharedFun;
+			}
+			if(m_job->arena != m_arena) {
+				m_job->arena = m_arena;
+			}
+			m_job->param.emplace(std::move(param));
+			m_job->result = CheckResult();
+			if(!m_watchdog->run(m_job, m_timeout)) {
+				// ケースは放棄したスレッドがまだ使っているので、コピーを残す。
+				m_result.failedCase = detail::copyCase(m_job->param.value());
+				m_result.reason.emplace("timed out (limit: "
+						+ std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(m_timeout).count())
+						+ "ms)");
+				if(m_result.failedCase.empty()) {
+					m_result.failedCase = std::string("(test case is not copy constructible)");
+				}
+				// 性質の複製(と、それが借りたフィクスチャ)も放棄したスレッドが使っているので、次のケースでは複製し直す。
+				m_job.reset();
+				m_sharedFun.reset();
+				return	true;
+			}
+			param = std::move(m_job->param.value());
+			m_job->param = PROTEST_NULLOPT;
+			if(m_job->error) {
+				std::rethrow_exception(std::exchange(m_job->error, nullptr));
+			}
+			if(m_job->result.isTestFailed()) {
+				m_result.failedCase = std::move(param);
+				m_result.reason = std::move(m_job->result.reason.value());
+				return	true;
+			}
+			return	false;
+		}
+		//! Fail the case if it took more than m_slowFactor times the median. Returns true if failed.
+		bool			isSlowCase(param_type &param, std::chrono::nanoseconds elapsed)
+		{
+			if((m_medianTime > std::chrono::nanoseconds::zero())
+					&& (static_cast<double>(elapsed.count()) > m_slowFactor * static_cast<double>(m_medianTime.count()))) {
+				m_result.failedCase = std::move(param);
+				m_result.reason.emplace("took " + std::to_string(elapsed.count()) + "ns, more than "
+						+ std::to_string(m_slowFactor) + " times the median " + std::to_string(m_medianTime.count()) + "ns");
+				return	true;
+			}
+			if(m_caseTimes.size() < caseTimeWindow) {
+				m_caseTimes.push_back(elapsed);
+			} else {
+				m_caseTimes[m_caseTimesNext] = elapsed;
+				m_caseTimesNext = (m_caseTimesNext + 1) % caseTimeWindow;
+			}
+			// 中央値はゆっくりとしか変わらないので、求め直すのは medianInterval 個ごとにする。
+			if((m_caseTimes.size() >= minCaseTimes) && ((m_medianTime == std::chrono::nanoseconds::zero()) || (++m_sinceMedian >= medianInterval))) {
+				m_sinceMedian = 0;
+				m_sortedTimes.assign(m_caseTimes.begin(), m_caseTimes.end());
+				const auto		mid = m_sortedTimes.begin() + m_sortedTimes.size() / 2;
+				std::nth_element(m_sortedTimes.begin(), mid, m_sortedTimes.end());
+				// 時計の分解能より短いケースばかりでも、0にはしない。
+				m_medianTime = std::max(*mid, std::chrono::nanoseconds(1));
+			}
+			return	false;
+		}
+		static bool		slower(const TimedCase &a, const TimedCase &b)
+		{
+			return	a.elapsed > b.elapsed;
+		}
+		//! Keep the case if it is one of the slowest m_slowestCount cases.
+		void			recordCaseTime(const param_type &param, std::chrono::steady_clock::duration elapsed)
+		{
+			auto			&slowest = m_result.slowestCases;
+			const auto		ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+			// slowest は最も速いものが先頭に来るヒープ。
+			if(slowest.size() < m_slowestCount) {
+				slowest.push_back(TimedCase{detail::copyCase(param), ns});
+				std::push_heap(slowest.begin(), slowest.end(), slower);
+			} else if(ns > slowest.front().elapsed) {
+				std::pop_heap(slowest.begin(), slowest.end(), slower);
+				slowest.back() = TimedCase{detail::copyCase(param), ns};
+				std::push_heap(slowest.begin(), slowest.end(), slower);
+			}
+		}
 }; // class SimpleTest
 
+// 標準の算術型についての実体は libprotest にある(instantiations.cpp)。
+// ヘッダだけで使う場合は PROTEST_NO_EXTERN_TEMPLATES を定義すること。
+#ifndef	PROTEST_NO_EXTERN_TEMPLATES
+#	define	PROTEST_EXTERN_SIMPLE_TEST_(T)	extern template class SimpleTest<T>;
+PROTEST_FOR_EACH_ARITHMETIC_TYPE(PROTEST_EXTERN_SIMPLE_TEST_)
+#	undef	PROTEST_EXTERN_SIMPLE_TEST_
+#endif
+
 } // namespace protest
 } // namespace nu11p0
 #endif	// ifndef INCLUDED__NU11P0__PROTEST__SIMPLE_TEST_HPP_
@@ -0,0 +1,125 @@
+/*!
+ * \file   snapshot.hpp
+ * \brief  Conditions comparing large outputs with golden files.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__SNAPSHOT_HPP_
+#define	INCLUDED__NU11P0__PROTEST__SNAPSHOT_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace	nu11p0 {
+namespace	protest {
+
+//! What checkSnapshot() does with the golden file.
+enum class	SnapshotMode {
+	//! ゴールデンファイルと比べる。
+	Compare,
+	//! 出力でゴールデンファイルを作り直す。比較はせず、常に成功する。
+	Update,
+};
+
+//! Update if the environment variable PROTEST_UPDATE_SNAPSHOTS is set to a non-empty value other than "0".
+SnapshotMode	defaultSnapshotMode(void);
+
+struct	SnapshotOptions {
+	SnapshotMode	mode;
+	//! ハッシュを取る単位。索引はこの大きさごとに作り直す。0は不正(checkSnapshot() が失敗する)。
+	size_t			chunkSize;
+	//! 理由に含める、食い違った領域の最大数。
+	size_t			maxRegions;
+	//! 各領域について、16進で表示するバイト数。
+	size_t			contextBytes;
+	SnapshotOptions()
+	:mode(defaultSnapshotMode())
+	,chunkSize(1 << 20)
+	,maxRegions(8)
+	,contextBytes(16)
+	{}
+}; // struct SnapshotOptions
+
+namespace	detail {
+
+	//! 64-bit hash of a chunk. Four independent lanes, so that it runs at memory bandwidth.
+	uint64_t		chunkHash(const void *data, size_t size);
+	//! Hashes of the chunks of the data. Empty if chunkSize is 0.
+	std::vector<uint64_t>	chunkHashes(const void *data, size_t size, size_t chunkSize);
+	//! Path of the sidecar index of the golden file.
+	std::string		snapshotIndexPath(const std::string &goldenPath);
+
+} // namespace detail
+
+//! Compare the output with the golden file, or regenerate it in the update mode.
+/*!
+ * ゴールデンファイルは mmap し、隣に置いた索引ファイル(ゴールデンファイル名 + ".idx")に
+ * chunkSize ごとのハッシュを記録しておく。
+ * 比較時には出力のハッシュだけを計算して索引と比べ、食い違ったチャンクのみゴールデンファイルを読む。
+ * そのため一致する部分のページはディスクから読み込まれず、数百MBの出力でも出力を1回読むだけで済む。
+ *
+ * 索引が無いか、ゴールデンファイルの大きさ、更新時刻、 chunkSize が索引と異なる場合は、
+ * ゴールデンファイル全体から索引を作り直して保存する。
+ *
+ * 失敗時の理由には大きさの違いと、食い違った領域(チャンクの中で最初と最後に異なるバイトの位置)を
+ * 最大 maxRegions 個、それぞれ先頭の contextBytes バイトを16進で含める。
+ * ハッシュが衝突した食い違いは見逃す(64ビットなので、実用上は起こらない)。
+ */
+CheckResult		checkSnapshot(const std::string &goldenPath, const void *data, size_t size,
+		const SnapshotOptions &options=SnapshotOptions());
+
+inline CheckResult	checkSnapshot(const std::string &goldenPath, const std::string &output,
+		const SnapshotOptions &options=SnapshotOptions())
+{
+	return	checkSnapshot(goldenPath, output.data(), output.size(), options);
+}
+
+//! Check that the rendered output of each case matches its golden file.
+/*!
+ * render は `data()' と `size()' を持つ連続したバイト列(std::string, std::vector<uint8_t> 等)を返す。
+ * ゴールデンファイルのパスは固定か、ケースごとに関数で決める。
+ */
+template <typename Param, typename Output=std::string>
+class	MatchesSnapshot {
+	public:
+		using	param_type = Param;
+		using	output_type = Output;
+	private:
+		std::function<std::string(const param_type &)>	m_path;
+		std::function<output_type(const param_type &)>	m_render;
+		SnapshotOptions	m_options;
+	public:
+		template <typename F>
+		MatchesSnapshot(const std::string &goldenPath, F &&render, const SnapshotOptions &options=SnapshotOptions())
+		:m_path([goldenPath](const param_type &) { return goldenPath; })
+		,m_render(std::forward<F>(render))
+		,m_options(options)
+		{}
+		template <typename F>
+		MatchesSnapshot(std::function<std::string(const param_type &)> goldenPath, F &&render,
+				const SnapshotOptions &options=SnapshotOptions())
+		:m_path(std::move(goldenPath))
+		,m_render(std::forward<F>(render))
+		,m_options(options)
+		{}
+		~MatchesSnapshot() = default;
+		MatchesSnapshot(const MatchesSnapshot &) = default;
+		MatchesSnapshot(MatchesSnapshot &&) = default;
+		CheckResult		operator()(const param_type &arg)
+		{
+			const output_type	output = m_render(arg);
+			return	checkSnapshot(m_path(arg), output.data(), output.size() * sizeof(*output.data()), m_options);
+		}
+}; // class MatchesSnapshot
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__SNAPSHOT_HPP_
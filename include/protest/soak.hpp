@@ -0,0 +1,97 @@
+/*!
+ * \file   soak.hpp
+ * \brief  Soak mode: running registered tests continuously with live metrics.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__SOAK_HPP_
+#define	INCLUDED__NU11P0__PROTEST__SOAK_HPP_
+
+#ifndef	INCLUDED__NU11P0__PROTEST__PROTEST_COMMON_HPP_
+#	include <protest/protest_common.hpp>
+#endif
+#ifndef	INCLUDED__NU11P0__PROTEST__RUNNER_HPP_
+#	include <protest/runner.hpp>
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace	nu11p0 {
+namespace	protest {
+
+//! Counters of a soak run, exported in the Prometheus text format.
+/*!
+ * テストごとに、実行回数、 passCount と skipCount の合計、失敗の数、直近の実行のケース/秒、
+ * skip の割合、ケースあたりの時間の分位数(p50, p90, p99)を集計する。
+ * ケースあたりの時間は、報告された結果ごとに elapsed をケースの数で割ったものを標本とし、
+ * 直近の latencyWindow 個から分位数を求める。
+ * 複数のスレッドから同時に使ってよい。
+ */
+class	SoakMetrics {
+	public:
+		static constexpr size_t	latencyWindow = 1024;
+	private:
+		struct	Entry {
+			size_t			runs = 0;
+			size_t			passes = 0;
+			size_t			skips = 0;
+			size_t			failures = 0;
+			double			lastRate = 0.0;
+			//! 直近の標本(秒)。 latencyWindow 個を超えたら古いものから上書きする。
+			std::vector<double>	latencies;
+			size_t			latencyNext = 0;
+			double			latencySum = 0.0;
+			size_t			latencyCount = 0;
+		}; // struct Entry
+		mutable std::mutex	m_mutex;
+		std::map<std::string, Entry>	m_entries;
+		std::chrono::steady_clock::time_point	m_start;
+	public:
+		SoakMetrics();
+		SoakMetrics(const SoakMetrics &) = delete;
+		SoakMetrics		&operator=(const SoakMetrics &) = delete;
+		//! Record a run of the test and the results it reported.
+		void			record(const std::string &test, const std::vector<TestResult> &results, std::chrono::nanoseconds elapsed);
+		//! Metrics in the Prometheus text exposition format.
+		std::string		prometheusText(void) const;
+		//! Write prometheusText() through a temporary file, so that a scraper never reads a partial file.
+		bool			writeFile(const std::string &path) const;
+}; // class SoakMetrics
+
+//! Ask the running runSoak() to stop after the running tests. Async-signal-safe.
+void			requestSoakStop(void);
+
+//! Run the selected tests repeatedly, until requestSoakStop() or opts.soakRounds rounds.
+/*!
+ * 選択したテストを登録順に巡回し、実行ごとに異なるシード(TestContext::seed())を与える。
+ * 各実行のシードは、基準のシード(opts.seed, 無ければ乱数)と周回数、テストの位置から決まり、
+ * 開始時に基準のシードを出力するので、失敗した実行は --filter と --seed で再現できる。
+ *
+ * 失敗した結果は、テストの名前、周回数、シードと共に opts.soakCorpus に1件1ファイルのJSON Linesで保存し、
+ * ost にも出力する。成功した結果は出力しない。
+ * opts.jobs が2以上なら、その数のスレッドで並行して巡回する。
+ *
+ * 統計(SoakMetrics)は、 opts.metricsFile に opts.metricsInterval ごとに書き出すほか、
+ * opts.metricsSocket を指定すると、その Unix ドメインソケットへの接続ごとに返す。
+ * \return 0 if no test failed, 1 otherwise.
+ */
+int				runSoak(const TestRegistry &registry, const RunnerOptions &opts, std::ostream &ost);
+
+namespace	detail {
+	//! Seed of the run of the index-th test in the round.
+	uint64_t		soakSeed(uint64_t base, size_t round, size_t index);
+	//! Escape the string as a Prometheus label value.
+	std::string		prometheusLabel(const std::string &str);
+} // namespace detail
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__SOAK_HPP_
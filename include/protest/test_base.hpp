@@ -18,10 +18,113 @@
 #endif
 
 
+#include <string>
+#include <utility>
+
 namespace	nu11p0 {
 namespace	protest {
 
+class	Arena;
+
+namespace	detail {
+	//! Check whether the test case generator accepts used cases by recycle().
+	template <typename TCG, typename T, typename=void>
+	struct	HasRecycle : std::false_type {};
+	template <typename TCG, typename T>
+	struct	HasRecycle<TCG, T, decltype(std::declval<TCG &>().recycle(std::declval<T &&>()), void())>
+		: std::true_type
+	{};
+
+	//! Give a used test case back to the generator, if it supports recycling.
+	template <typename TCG, typename T>
+	auto			recycleCase(TCG &gen, T &&val)
+		-> std::enable_if_t<HasRecycle<TCG, std::decay_t<T>>{}>
+	{
+		gen.recycle(std::move(val));
+	}
+	template <typename TCG, typename T>
+	auto			recycleCase(TCG &, T &&)
+		-> std::enable_if_t<!HasRecycle<TCG, std::decay_t<T>>{}>
+	{}
+
+	//! Check whether the test case generator can allocate cases from Arena.
+	template <typename TCG, typename=void>
+	struct	HasBindArena : std::false_type {};
+	template <typename TCG>
+	struct	HasBindArena<TCG, decltype(std::declval<TCG &>().bindArena(std::declval<Arena &>()), void())>
+		: std::true_type
+	{};
+
+	//! Let the generator allocate cases from the arena, if it supports.
+	template <typename TCG>
+	auto			bindArena(TCG &gen, Arena &arena)
+		-> std::enable_if_t<HasBindArena<TCG>{}>
+	{
+		gen.bindArena(arena);
+	}
+	template <typename TCG>
+	auto			bindArena(TCG &, Arena &)
+		-> std::enable_if_t<!HasBindArena<TCG>{}>
+	{}
+
+	//! Check whether the test case generator counts distinct cases.
+	template <typename TCG, typename=void>
+	struct	HasDistinctCount : std::false_type {};
+	template <typename TCG>
+	struct	HasDistinctCount<TCG, decltype(static_cast<size_t>(std::declval<const TCG &>().distinctCount()), void())>
+		: std::true_type
+	{};
+
+	//! Copy the number of distinct cases to the result, if the generator counts them.
+	template <typename TCG>
+	auto			recordDistinctCount(const TCG &gen, TestResult &result)
+		-> std::enable_if_t<HasDistinctCount<TCG>{}>
+	{
+		result.distinctCount = gen.distinctCount();
+	}
+	template <typename TCG>
+	auto			recordDistinctCount(const TCG &, TestResult &)
+		-> std::enable_if_t<!HasDistinctCount<TCG>{}>
+	{}
+
+	//! Check whether the test case generator can save and load its position.
+	template <typename TCG, typename=void>
+	struct	HasGeneratorState : std::false_type {};
+	template <typename TCG>
+	struct	HasGeneratorState<TCG, decltype(
+			static_cast<bool>(std::declval<const TCG &>().saveState(std::declval<std::string &>())),
+			static_cast<bool>(std::declval<TCG &>().loadState(std::declval<const std::string &>())),
+			void())>
+		: std::true_type
+	{};
 
+	//! Serialize the position of the generator. Returns false if it is not supported.
+	template <typename TCG>
+	auto			saveGeneratorState(const TCG &gen, std::string &state)
+		-> std::enable_if_t<HasGeneratorState<TCG>{}, bool>
+	{
+		return	gen.saveState(state);
+	}
+	template <typename TCG>
+	auto			saveGeneratorState(const TCG &, std::string &)
+		-> std::enable_if_t<!HasGeneratorState<TCG>{}, bool>
+	{
+		return	false;
+	}
+	//! Restore the position of the generator. Returns false if it is not supported.
+	template <typename TCG>
+	auto			loadGeneratorState(TCG &gen, const std::string &state)
+		-> std::enable_if_t<HasGeneratorState<TCG>{}, bool>
+	{
+		return	gen.loadState(state);
+	}
+	template <typename TCG>
+	auto			loadGeneratorState(TCG &, const std::string &)
+		-> std::enable_if_t<!HasGeneratorState<TCG>{}, bool>
+	{
+		return	false;
+	}
+} // namespace detail
 
 } // namespace protest
 } // namespace nu11p0
@@ -0,0 +1,58 @@
+/*!
+ * \file   watchdog.hpp
+ * \brief  Worker thread which runs test cases with a time limit.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#pragma	once
+#ifndef	INCLUDED__NU11P0__PROTEST__WATCHDOG_HPP_
+#define	INCLUDED__NU11P0__PROTEST__WATCHDOG_HPP_
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace	nu11p0 {
+namespace	protest {
+
+//! Job run by Watchdog.
+/*!
+ * タイムアウトした場合、ジョブは Watchdog から切り離されたスレッドで実行され続けるので、
+ * ジョブが使うものは全てジョブ自身が(shared_ptr等で)保持すること。
+ */
+class	WatchdogJob {
+	public:
+		virtual			~WatchdogJob();
+		virtual void	run(void) = 0;
+}; // class WatchdogJob
+
+//! Run jobs on a worker thread, with a time limit.
+/*!
+ * 実行中のスレッドを安全に止める方法はないので、時間内に終わらなかったジョブのスレッドは
+ * 放棄(detach)し、次のジョブは新しいスレッドで実行する。
+ * 放棄されたスレッドは、ジョブが終わった時点で終了する。
+ */
+class	Watchdog {
+	private:
+		struct	State;
+		std::shared_ptr<State>	m_state;
+		std::thread		m_thread;
+		static void		workerMain(std::shared_ptr<State> state);
+	public:
+		Watchdog();
+		~Watchdog();
+		Watchdog(const Watchdog &) = delete;
+		Watchdog		&operator=(const Watchdog &) = delete;
+		//! Run the job on the worker thread and wait for it.
+		/*!
+		 * \return false if the job did not finish within the timeout.
+		 */
+		bool			run(const std::shared_ptr<WatchdogJob> &job, std::chrono::nanoseconds timeout);
+		//! Number of threads abandoned so far by all watchdogs.
+		static size_t	abandonedCount(void);
+}; // class Watchdog
+
+} // namespace protest
+} // namespace nu11p0
+#endif	// ifndef INCLUDED__NU11P0__PROTEST__WATCHDOG_HPP_
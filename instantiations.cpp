@@ -0,0 +1,36 @@
+/*!
+ * \file   instantiations.cpp
+ * \brief  Explicit instantiations of test classes for the standard arithmetic types.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <protest/simple_test.hpp>
+#include <protest/case_gen.hpp>
+#include <protest/generic_test.hpp>
+
+// ヘッダの extern template に対応する定義。
+// generic::test は関数オブジェクトの型に依存するので、利用側で実体化される。
+// その中で使われる SimpleTest, Random, Edge はここの実体が使われる。
+
+namespace	nu11p0 {
+namespace	protest {
+
+#define	PROTEST_INSTANTIATE_SIMPLE_TEST_(T)	template class SimpleTest<T>;
+PROTEST_FOR_EACH_ARITHMETIC_TYPE(PROTEST_INSTANTIATE_SIMPLE_TEST_)
+#undef	PROTEST_INSTANTIATE_SIMPLE_TEST_
+
+namespace	case_gen {
+
+#define	PROTEST_INSTANTIATE_CASE_GEN_(T) \
+	template class Random<T>; \
+	template class IterableSource<std::vector<T>>; \
+	template class Pool<std::vector<T>>; \
+	template class Edge<T>;
+PROTEST_FOR_EACH_ARITHMETIC_TYPE(PROTEST_INSTANTIATE_CASE_GEN_)
+#undef	PROTEST_INSTANTIATE_CASE_GEN_
+
+} // namespace case_gen
+
+} // namespace protest
+} // namespace nu11p0
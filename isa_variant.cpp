@@ -0,0 +1,76 @@
+/*!
+ * \file   isa_variant.cpp
+ * \brief  Differential conditions across instruction set variants of a kernel.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <protest/isa_variant.hpp>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#	define	PROTEST_HAVE_CPU_SUPPORTS_
+#endif
+
+namespace	nu11p0 {
+namespace	protest {
+
+const char		*isaName(IsaLevel level)
+{
+	switch(level) {
+		case IsaLevel::Scalar:
+			return	"scalar";
+		case IsaLevel::Sse42:
+			return	"SSE4.2";
+		case IsaLevel::Avx2:
+			return	"AVX2";
+		case IsaLevel::Avx512:
+			return	"AVX-512";
+	}
+	return	"unknown";
+}
+
+bool			isaSupported(IsaLevel level)
+{
+#ifdef	PROTEST_HAVE_CPU_SUPPORTS_
+	// 静的初期化の順序に依らず使えるよう、 cpu_init を先に呼んでおく。
+	__builtin_cpu_init();
+#endif
+	switch(level) {
+		case IsaLevel::Scalar:
+			return	true;
+#ifdef	PROTEST_HAVE_CPU_SUPPORTS_
+		case IsaLevel::Sse42:
+			return	__builtin_cpu_supports("sse4.2");
+		case IsaLevel::Avx2:
+			// OS が YMM レジスタを保存しない場合は、 libgcc が avx2 を無効として扱う。
+			return	__builtin_cpu_supports("avx2");
+		case IsaLevel::Avx512:
+			return	__builtin_cpu_supports("avx512f");
+#else
+		case IsaLevel::Sse42:
+		case IsaLevel::Avx2:
+		case IsaLevel::Avx512:
+			return	false;
+#endif
+	}
+	return	false;
+}
+
+namespace	detail {
+
+std::string		describeDifference(const std::vector<IsaLevel> &levels, IsaLevel base)
+{
+	std::string		ret;
+	for(const auto level : levels) {
+		if(!ret.empty()) {
+			ret += ", ";
+		}
+		ret += isaName(level);
+	}
+	return	ret + ((levels.size() == 1) ? " differs from " : " differ from ") + isaName(base);
+}
+
+} // namespace detail
+
+} // namespace protest
+} // namespace nu11p0
@@ -0,0 +1,125 @@
+/*!
+ * \file   perf_condition.cpp
+ * \brief  Conditions on the execution time of functions.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <protest/perf_condition.hpp>
+
+namespace	nu11p0 {
+namespace	protest {
+namespace	detail {
+
+namespace	{
+
+//! 並べ替え済みの標本の中央値。
+//! 外れ値の判定に使う MAD の、中央値に対する下限。
+constexpr double	madFloorRatio = 0.01;
+
+double			sortedMedian(const std::vector<double> &sorted, size_t n)
+{
+	return	(n % 2) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+}
+
+//! 標準正規分布の両側 confidence の区間に対応する z 値。
+double			normalQuantile(double confidence)
+{
+	// Abramowitz and Stegun 26.2.23 による上側確率 p の近似。誤差は 4.5e-4 以下。
+	double			p = (1.0 - confidence) / 2.0;
+	if(p <= 0.0) {
+		p = 1e-12;
+	} else if(p > 0.5) {
+		p = 0.5;
+	}
+	const double	t = std::sqrt(-2.0 * std::log(p));
+	return	t - (2.515517 + 0.802853 * t + 0.010328 * t * t)
+		/ (1.0 + 1.432788 * t + 0.189269 * t * t + 0.001308 * t * t * t);
+}
+
+std::string		formatWithUnit(double val, const char *unit)
+{
+	char			buf[64];
+	std::snprintf(buf, sizeof(buf), "%.3g%s", val, unit);
+	return	buf;
+}
+
+} // anonymous namespace
+
+PerfSummary		summarizeSamples(std::vector<double> &samples, const PerfOptions &opts)
+{
+	PerfSummary		summary;
+	if(samples.empty()) {
+		return	summary;
+	}
+	std::sort(samples.begin(), samples.end());
+	size_t			n = samples.size();
+	if(opts.outlierThreshold > 0.0) {
+		// 計測のノイズは遅くなる方向にしか出ないので、遅すぎる標本だけを捨てる。
+		const double	median = sortedMedian(samples, n);
+		std::vector<double>	deviations(n);
+		for(size_t i = 0; i < n; ++i) {
+			deviations[i] = std::fabs(samples[i] - median);
+		}
+		std::sort(deviations.begin(), deviations.end());
+		// 1.4826 * MAD は正規分布の標準偏差の推定量になる。
+		// 時計の分解能が粗いと半分以上の標本が同じ値になって MAD が0になり、
+		// 中央値より少しでも遅い標本を全て捨ててしまうので、中央値の1%を下限とする。
+		const double	mad = std::max(1.4826 * sortedMedian(deviations, n), std::fabs(median) * madFloorRatio);
+		const double	limit = median + opts.outlierThreshold * mad;
+		while((n > 1) && (samples[n - 1] > limit)) {
+			--n;
+		}
+	}
+	summary.samples = n;
+	summary.rejected = samples.size() - n;
+	summary.median = sortedMedian(samples, n);
+	// 中央値の信頼区間: 1始まりの順位 floor(n/2 - z*sqrt(n)/2) と ceil(1 + n/2 + z*sqrt(n)/2) の順序統計量。
+	// 添字は0始まりなので、どちらも1を引く。
+	const double	half = normalQuantile(opts.confidence) * std::sqrt(static_cast<double>(n)) / 2.0;
+	const double	lowRank = std::floor(static_cast<double>(n) / 2.0 - half) - 1.0;
+	const double	highRank = std::ceil(static_cast<double>(n) / 2.0 + half);
+	summary.lower = samples[(lowRank < 0.0) ? 0 : static_cast<size_t>(lowRank)];
+	summary.upper = samples[(highRank >= static_cast<double>(n)) ? (n - 1) : static_cast<size_t>(highRank)];
+	return	summary;
+}
+
+std::string		formatNanoseconds(double ns)
+{
+	if(ns < 1e3) {
+		return	formatWithUnit(ns, "ns");
+	} else if(ns < 1e6) {
+		return	formatWithUnit(ns / 1e3, "us");
+	} else if(ns < 1e9) {
+		return	formatWithUnit(ns / 1e6, "ms");
+	}
+	return	formatWithUnit(ns / 1e9, "s");
+}
+
+std::string		formatRatio(double ratio)
+{
+	return	formatWithUnit(ratio, "x");
+}
+
+std::string		describeSummary(const PerfSummary &summary, const PerfOptions &opts, std::string (*format)(double))
+{
+	char			level[16];
+	std::snprintf(level, sizeof(level), "%g%%", opts.confidence * 100.0);
+	std::string		ret = format(summary.median);
+	ret += " (";
+	ret += level;
+	ret += " CI [" + format(summary.lower) + ", " + format(summary.upper) + "], ";
+	ret += std::to_string(summary.samples) + " samples";
+	if(summary.rejected) {
+		ret += ", " + std::to_string(summary.rejected) + " outliers rejected";
+	}
+	ret += ')';
+	return	ret;
+}
+
+} // namespace detail
+} // namespace protest
+} // namespace nu11p0
@@ -0,0 +1,229 @@
+/*!
+ * \file   perf_counter.cpp
+ * \brief  Hardware and software performance counters.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <cstring>
+#include <ctime>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <protest/perf_counter.hpp>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#	include <linux/perf_event.h>
+#	include <sys/ioctl.h>
+#	include <sys/syscall.h>
+#	define	PROTEST_HAVE_PERF_EVENT_
+#endif
+
+namespace	nu11p0 {
+namespace	protest {
+
+namespace	{
+
+#ifdef	PROTEST_HAVE_PERF_EVENT_
+struct	EventConfig {
+	PerfCounts::Event	event;
+	uint32_t		type;
+	uint64_t		config;
+};
+
+// 先頭がグループのリーダーになる。
+const EventConfig	hardwareEvents[] = {
+	{PerfCounts::Cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+	{PerfCounts::Instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+	{PerfCounts::CacheMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+	{PerfCounts::BranchMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+const EventConfig	softwareEvents[] = {
+	{PerfCounts::TaskClock, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+	{PerfCounts::PageFaults, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+};
+
+int				openEvent(const EventConfig &config, int groupFd)
+{
+	struct perf_event_attr	attr;
+	std::memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = config.type;
+	attr.config = config.config;
+	// リーダーだけ無効状態で開き、グループごと有効・無効を切り替える。
+	attr.disabled = (groupFd == -1);
+	// perf_event_paranoid=2 でも開けるよう、ユーザ空間のみ計測する。
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	return	static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+#endif	// ifdef PROTEST_HAVE_PERF_EVENT_
+
+uint64_t		threadCpuNanoseconds(void)
+{
+	struct timespec	ts;
+#ifdef	CLOCK_THREAD_CPUTIME_ID
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+#else
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+#endif
+	return	static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+uint64_t		pageFaults(void)
+{
+	struct rusage	usage;
+#ifdef	RUSAGE_THREAD
+	getrusage(RUSAGE_THREAD, &usage);
+#else
+	getrusage(RUSAGE_SELF, &usage);
+#endif
+	return	static_cast<uint64_t>(usage.ru_minflt) + static_cast<uint64_t>(usage.ru_majflt);
+}
+
+} // anonymous namespace
+
+PerfCounterGroup::PerfCounterGroup()
+:m_fds()
+,m_events()
+,m_count()
+,m_leaders()
+,m_groups()
+,m_source(Source::None)
+,m_rusage(false)
+,m_startClock()
+,m_startFaults()
+,m_accumulated()
+{}
+
+PerfCounterGroup::~PerfCounterGroup()
+{
+	close();
+}
+
+PerfCounterGroup::Source	PerfCounterGroup::open(void)
+{
+	if(m_source != Source::None) {
+		return	m_source;
+	}
+#ifdef	PROTEST_HAVE_PERF_EVENT_
+	// ハードウェアとソフトウェアのイベントは同じグループにできない(種類の異なるPMUは同時に動かせない)ので、
+	// 別のグループとして開く。
+	const auto		tryOpen = [this](const EventConfig *configs, size_t n) {
+			const size_t	leader = m_count;
+			for(size_t i = 0; i < n; ++i) {
+				const int		fd = openEvent(configs[i], (m_count > leader) ? m_fds[leader] : -1);
+				if(fd >= 0) {
+					m_fds[m_count] = fd;
+					m_events[m_count] = configs[i].event;
+					++m_count;
+				} else if(m_count == leader) {
+					// リーダーが開けなければ、この種類のカウンタは使えない。
+					return	false;
+				}
+			}
+			ioctl(m_fds[leader], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			m_leaders[m_groups++] = leader;
+			return	true;
+		};
+	const bool		hardware = tryOpen(hardwareEvents, sizeof(hardwareEvents) / sizeof(hardwareEvents[0]));
+	const bool		software = tryOpen(softwareEvents, sizeof(softwareEvents) / sizeof(softwareEvents[0]));
+	m_rusage = !software;
+	m_source = hardware ? Source::Hardware : software ? Source::Software : Source::Rusage;
+	return	m_source;
+#else
+	m_rusage = true;
+	m_source = Source::Rusage;
+	return	m_source;
+#endif
+}
+
+void			PerfCounterGroup::close(void)
+{
+	for(size_t i = 0; i < m_count; ++i) {
+		::close(m_fds[i]);
+	}
+	m_count = 0;
+	m_groups = 0;
+	m_source = Source::None;
+	m_rusage = false;
+	m_accumulated = PerfCounts();
+}
+
+PerfCounterGroup::Source	PerfCounterGroup::source(void) const
+{
+	return	m_source;
+}
+
+void			PerfCounterGroup::start(void)
+{
+#ifdef	PROTEST_HAVE_PERF_EVENT_
+	for(size_t g = 0; g < m_groups; ++g) {
+		ioctl(m_fds[m_leaders[g]], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+#endif
+	if(m_rusage) {
+		m_startFaults = pageFaults();
+		m_startClock = threadCpuNanoseconds();
+	}
+}
+
+void			PerfCounterGroup::stop(void)
+{
+#ifdef	PROTEST_HAVE_PERF_EVENT_
+	for(size_t g = m_groups; g; --g) {
+		ioctl(m_fds[m_leaders[g - 1]], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+	}
+#endif
+	if(m_rusage) {
+		const uint64_t	clock = threadCpuNanoseconds();
+		const uint64_t	faults = pageFaults();
+		PerfCounts		delta;
+		delta.set(PerfCounts::TaskClock, clock - m_startClock);
+		delta.set(PerfCounts::PageFaults, faults - m_startFaults);
+		m_accumulated += delta;
+	}
+}
+
+PerfCounts		PerfCounterGroup::read(void)
+{
+	// m_rusage でなければ m_accumulated は空。
+	PerfCounts		counts = m_accumulated;
+#ifdef	PROTEST_HAVE_PERF_EVENT_
+	for(size_t g = 0; g < m_groups; ++g) {
+		const size_t	leader = m_leaders[g];
+		const size_t	end = (g + 1 < m_groups) ? m_leaders[g + 1] : m_count;
+		// PERF_FORMAT_GROUP: nr, time_enabled, time_running, values[nr]
+		uint64_t		buf[3 + PerfCounts::EventCount];
+		const ssize_t	size = ::read(m_fds[leader], buf, sizeof(buf));
+		if(size < static_cast<ssize_t>(3 * sizeof(uint64_t))) {
+			continue;
+		}
+		const uint64_t	nr = buf[0];
+		const uint64_t	enabled = buf[1];
+		const uint64_t	running = buf[2];
+		for(size_t i = 0; (i < nr) && (leader + i < end); ++i) {
+			uint64_t		val = buf[3 + i];
+			// カウンタが多重化されていた場合は、動いていた時間の割合で補正する。
+			if(running && (running < enabled)) {
+				val = static_cast<uint64_t>(static_cast<double>(val) * static_cast<double>(enabled) / static_cast<double>(running));
+			}
+			counts.set(m_events[leader + i], val);
+		}
+	}
+#endif
+	return	counts;
+}
+
+void			PerfCounterGroup::reset(void)
+{
+#ifdef	PROTEST_HAVE_PERF_EVENT_
+	for(size_t g = 0; g < m_groups; ++g) {
+		ioctl(m_fds[m_leaders[g]], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	}
+#endif
+	m_accumulated = PerfCounts();
+}
+
+} // namespace protest
+} // namespace nu11p0
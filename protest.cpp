@@ -6,6 +6,7 @@
  * C++ version: C++14
  */
 #include <ostream>
+#include <streambuf>
 #include <protest/protest_common.hpp>
 
 #include <protest/loligger_sgr_macro.h>
@@ -21,10 +22,78 @@ void			printResult(std::ostream &ost, const TestResult &result)
 	} else {
 		ost << "[" SGR(BOLD, FG_RED) "FAIL" SGR(RESET) "] ";
 	}
-	ost << result.abstract << " (with test case: " << result.lastCaseDescription << ") (pass=" << result.passCount << ", skip=" << result.skipCount << ')' << std::endl;
+	// 行ごとにフラッシュ(std::endl)せず、結果全体を書いてから一度だけフラッシュする。
+	ost << result.abstract << " (with test case: " << result.lastCaseDescription << ") (pass=" << result.passCount << ", skip=" << result.skipCount;
+	if(result.distinctCount) {
+		ost << ", distinct=" << result.distinctCount;
+	}
+	ost << ")\n";
 	if(!success && result.reason) {
-		ost << "     | reason: " << result.reason.value() << std::endl;
+		ost << "     | reason: " << result.reason.value() << '\n';
+	}
+	if(!result.complexity.bestFit.empty()) {
+		ost << "     | complexity: " << result.complexity.bestFit << " (";
+		for(const auto &s : result.complexity.series) {
+			if(&s != &result.complexity.series.front()) {
+				ost << ", ";
+			}
+			ost << "n=" << s.size << ": " << s.elapsed.count() << "ns";
+		}
+		ost << ")\n";
+	}
+	if(!result.counters.empty()) {
+		ost << "     | counters:";
+		for(size_t i = 0; i < PerfCounts::EventCount; ++i) {
+			const auto		e = static_cast<PerfCounts::Event>(i);
+			if(result.counters.has(e)) {
+				ost << ' ' << PerfCounts::name(e) << '=' << result.counters.get(e);
+			}
+		}
+		ost << '\n';
+	}
+	if(!result.slowestCases.empty()) {
+		ost << "     | slowest:";
+		for(const auto &c : result.slowestCases) {
+			ost << ' ' << std::chrono::duration_cast<std::chrono::microseconds>(c.elapsed).count() << "us";
+		}
+		ost << '\n';
 	}
+	ost.flush();
+}
+
+namespace	{
+
+//! Stream buffer which discards everything. It has no state, so it can be shared by threads.
+class	NullStreambuf : public std::streambuf {
+	protected:
+		int_type		overflow(int_type c) override
+		{
+			return	traits_type::not_eof(c);
+		}
+		std::streamsize	xsputn(const char_type *, std::streamsize n) override
+		{
+			return	n;
+		}
+};
+
+NullStreambuf	&nullStreambuf(void)
+{
+	static NullStreambuf	buf;
+	return	buf;
+}
+
+} // anonymous namespace
+
+std::ostream	&nullOstream(void)
+{
+	// 書き込みは常に成功するので、状態(badbit等)は変わらない。
+	thread_local std::ostream	ost(&nullStreambuf());
+	return	ost;
+}
+
+bool			isOstreamAvailable(const std::ostream &ost)
+{
+	return	ost.rdbuf() != &nullStreambuf();
 }
 
 } // namespace protest
@@ -0,0 +1,13 @@
+/*!
+ * \file   protest_main.cpp
+ * \brief  main() for suites which register tests with protest::Registration.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <protest/runner.hpp>
+
+int				main(int argc, char **argv)
+{
+	return	nu11p0::protest::runMain(argc, argv);
+}
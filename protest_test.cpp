@@ -6,20 +6,58 @@
  * C++ version: C++14
  */
 
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <fstream>
 #include <functional>
 #include <tuple>
 #include <limits>
 #include <cmath>
+#include <cfloat>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
 
 #include <typeinfo>
+#include <dirent.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 #include <protest/generic_test.hpp>
 #include <protest/condition.hpp>
+#include <protest/bulk_condition.hpp>
+#include <protest/equivalent.hpp>
+#include <protest/isa_variant.hpp>
+#include <protest/snapshot.hpp>
+#include <protest/alloc_tracker.hpp>
+#include <protest/async_test.hpp>
+#include <protest/complexity.hpp>
+#include <protest/fuzz.hpp>
+#include <protest/perf_condition.hpp>
+#include <protest/reporter.hpp>
+#include <protest/runner.hpp>
+#include <protest/history.hpp>
+#include <protest/fixture.hpp>
+#include <protest/soak.hpp>
 
 //using namespace	nu11p0::protest;
 namespace	protest = nu11p0::protest;
 
+// libprotest のカバレッジのコールバック。計装されたコードの代わりに直接呼ぶ。
+extern "C" void	__sanitizer_cov_trace_pc_guard_init(uint32_t *start, uint32_t *stop);
+extern "C" void	__sanitizer_cov_trace_pc_guard(uint32_t *guard);
+
 int fun(int a)
 {
 	return	a;
@@ -87,7 +125,7 @@ int				absoluteInt64Test(void)
 				std::cout);
 		printResult(std::cout, result);
 		if(result.isTestFailed()) {
-			std::cout << "     | failed case: " << protest::ns_any::any_cast<int64_t>(result.failedCase) << std::endl;
+			std::cout << "     | failed case: " << protest::case_cast<int64_t>(result.failedCase) << std::endl;
 			return	1;
 		}
 		test.clearAll();
@@ -100,7 +138,7 @@ int				absoluteInt64Test(void)
 
 		printResult(std::cout, result);
 		if(result.isTestFailed()) {
-			std::cout << "     | failed case: " << protest::ns_any::any_cast<int64_t>(result.failedCase) << std::endl;
+			std::cout << "     | failed case: " << protest::case_cast<int64_t>(result.failedCase) << std::endl;
 			return	2;
 		}
 	}
@@ -122,7 +160,7 @@ int				absoluteInt64Test(void)
 				std::cout);
 		printResult(std::cout, result);
 		if(result.isTestFailed()) {
-			std::cout << "     | failed case: " << protest::ns_any::any_cast<int64_t>(result.failedCase) << std::endl;
+			std::cout << "     | failed case: " << protest::case_cast<int64_t>(result.failedCase) << std::endl;
 			return	3;
 		}
 		test.clearAll();
@@ -135,7 +173,7 @@ int				absoluteInt64Test(void)
 
 		printResult(std::cout, result);
 		if(result.isTestFailed()) {
-			std::cout << "     | failed case: " << protest::ns_any::any_cast<int64_t>(result.failedCase) << std::endl;
+			std::cout << "     | failed case: " << protest::case_cast<int64_t>(result.failedCase) << std::endl;
 			return	4;
 		}
 	}
@@ -319,6 +357,1446 @@ int				protestGenericUtilTest(void)
 	return	0;
 }
 
+int				passAsNthTypeTest(void)
+{
+	using	Types = std::tuple<int8_t, std::string, double, std::vector<int32_t>>;
+	const auto		describe = [](const auto &x) { return	std::string(typeid(x).name()); };
+	protest::CaseHolder	holder(std::string("case"));
+	const auto		name = protest::passAsNthType<Types>(describe, holder, 1);
+	if(protest::ns_any::any_cast<std::string>(name) != typeid(std::string).name()) {
+		std::cout << "error: passAsNthType dispatched to a wrong type" << std::endl;
+		return	1;
+	}
+	try {
+		protest::passAsNthType<Types>(describe, holder, 4);
+		std::cout << "error: passAsNthType accepted an index out of range" << std::endl;
+		return	2;
+	} catch(const std::out_of_range &) {
+	}
+	return	0;
+}
+
+int				genericBudgetTest(void)
+{
+	const auto		alwaysTrue = [](auto) {
+			return	protest::AssertResult(true, "");
+		};
+	const protest::generic::PreconditionAlwaysTrue	noPrecondition;
+	// uint8_t は値が256個しかないので、同じ値を繰り返さない生成器ではそれ以上は試さない。
+	auto			result = protest::generic::test<protest::generic::Unique, std::tuple<uint32_t, uint8_t>>(
+			"generic::test caps the count at the domain size", "unique case", alwaysTrue, noPrecondition, 1000);
+	if(result.result.isTestFailed() || (result.failedIndex != 1) || (result.result.passCount != 256)) {
+		std::cout << "error: count for uint8_t is not capped: " << result.result.passCount << std::endl;
+		return	1;
+	}
+	// Random は重複して生成するので、打ち切らない。
+	result = protest::generic::test<protest::generic::Random, std::tuple<uint32_t, uint8_t>>(
+			"generic::test does not cap random cases", "random case", alwaysTrue, noPrecondition, 1000);
+	if(result.result.isTestFailed() || (result.failedIndex != 1) || (result.result.passCount != 1000)) {
+		std::cout << "error: count for random uint8_t is capped: " << result.result.passCount << std::endl;
+		return	2;
+	}
+	result = protest::generic::test<protest::generic::Random, std::tuple<int8_t, int64_t>>(
+			"generic::test with per-type counts", "random case", alwaysTrue, noPrecondition, std::make_tuple(10, 20));
+	if(result.result.isTestFailed() || (result.result.passCount != 20)) {
+		std::cout << "error: per-type count (tuple) is not used: " << result.result.passCount << std::endl;
+		return	3;
+	}
+	result = protest::generic::test<protest::generic::Random, std::tuple<int8_t, int64_t>>(
+			"generic::test with per-type counts", "random case", alwaysTrue, noPrecondition, std::array<size_t, 2>{{10, 7}});
+	if(result.result.isTestFailed() || (result.result.passCount != 7)) {
+		std::cout << "error: per-type count (array) is not used: " << result.result.passCount << std::endl;
+		return	4;
+	}
+	// 重みは 8:32 なので uint8_t の取り分は600になるが、256で打ち切られて残りは int32_t に回る。
+	result = protest::generic::test<protest::generic::Exhaustive, std::tuple<uint8_t, int32_t>>(
+			"generic::test with a case budget", "exhaustive case", alwaysTrue, noPrecondition, protest::generic::AdaptiveBudget(3000));
+	if(result.result.isTestFailed() || (result.result.passCount != 3000 - 256)) {
+		std::cout << "error: case budget is not spread as expected: " << result.result.passCount << std::endl;
+		return	5;
+	}
+	// Random では打ち切らないので、 int32_t は取り分の2400のまま。
+	result = protest::generic::test<protest::generic::Random, std::tuple<uint8_t, int32_t>>(
+			"generic::test with a case budget", "random case", alwaysTrue, noPrecondition, protest::generic::AdaptiveBudget(3000));
+	if(result.result.isTestFailed() || (result.result.passCount != 2400)) {
+		std::cout << "error: random case budget is not spread as expected: " << result.result.passCount << std::endl;
+		return	6;
+	}
+	result = protest::generic::test<protest::generic::Random, std::tuple<uint8_t, uint64_t>>(
+			"generic::test with a time budget", "random case", alwaysTrue, noPrecondition,
+			protest::generic::AdaptiveBudget(std::chrono::milliseconds(20), 50), std::cout);
+	if(result.result.isTestFailed() || (result.result.passCount <= 50)) {
+		std::cout << "error: time budget is not spread as expected: " << result.result.passCount << std::endl;
+		return	7;
+	}
+	return	0;
+}
+
+int				uniqueTest(void)
+{
+	const auto		alwaysTrue = [](const auto &) {
+			return	protest::AssertResult(true, "");
+		};
+	// uint8_t の全ての値を生成したら、 maxCount に届かなくても終わる。
+	protest::SimpleTest<uint8_t>	byteTest("Unique<uint8_t> covers the domain", alwaysTrue);
+	protest::case_gen::Unique<uint8_t>	bytes;
+	auto			result = byteTest.runTest("unique random case", bytes, 100000, std::cout);
+	printResult(std::cout, result);
+	if(result.isTestFailed() || (result.passCount != 256) || (result.distinctCount != 256) || !bytes.saturated()) {
+		return	1;
+	}
+	// 生成器が0から99までしか生成しない場合は、既出の値が続いたところで終わる。
+	protest::SimpleTest<int32_t>	intTest("Unique<int32_t> stops at the reachable domain", alwaysTrue);
+	auto			smallInts = [dist=std::uniform_int_distribution<int32_t>(0, 99), engine=std::mt19937(std::random_device()())]() mutable {
+			return	dist(engine);
+		};
+	protest::case_gen::Unique<int32_t>	ints{protest::case_gen::Random<int32_t>(smallInts)};
+	result = intTest.runTest("unique random case in [0, 100)", ints, 100000, std::cout);
+	printResult(std::cout, result);
+	if(result.isTestFailed() || (result.passCount != 100) || (result.distinctCount != 100) || !ints.saturated()) {
+		return	2;
+	}
+	// capacity を大きく超えても、偽陽性で飽和したとみなさない。生成器は左辺値でも渡せる。
+	int32_t			next = 0;
+	auto			counting = [&next]() { return	protest::ns_optional::optional<int32_t>(next++); };
+	protest::case_gen::Unique<int32_t, decltype(counting)>	growing(counting, 1024, 64);
+	intTest.clearAll();
+	result = intTest.runTest("unique counting case", growing, 200000, std::cout);
+	printResult(std::cout, result);
+	if(result.isTestFailed() || growing.saturated() || (result.passCount != 200000) || (next > 200000 * 102 / 100)) {
+		std::cout << "error: Unique lost distinct cases beyond the capacity: " << next << std::endl;
+		return	3;
+	}
+	return	0;
+}
+
+int				checkpointTest(void)
+{
+	// 生成器の位置を保存して、別の生成器で続きから生成する。
+	const auto		continues = [](auto &&gen, auto &&restored, size_t skip) {
+			for(size_t i = 0; i < skip; ++i) {
+				gen();
+			}
+			std::string		state;
+			if(!gen.saveState(state) || !restored.loadState(state)) {
+				return	false;
+			}
+			// 浮動小数点数もあるので、ビット列で比べる。
+			const auto		expected = gen().value();
+			const auto		actual = restored().value();
+			return	std::memcmp(&expected, &actual, sizeof(expected)) == 0;
+		};
+	if(!continues(protest::case_gen::Random<uint32_t>(), protest::case_gen::Random<uint32_t>(), 5)
+			|| !continues(protest::case_gen::Random<double>(), protest::case_gen::Random<double>(), 5)
+			|| !continues(protest::case_gen::Edge<int8_t>(), protest::case_gen::Edge<int8_t>(), 2)
+			|| !continues(protest::case_gen::Exhaustive<int16_t>(), protest::case_gen::Exhaustive<int16_t>(), 300)) {
+		std::cout << "error: generator state is not restored" << std::endl;
+		return	1;
+	}
+	protest::case_gen::Exhaustive<uint8_t>	bytes;
+	size_t			byteCount = 0;
+	while(bytes()) {
+		++byteCount;
+	}
+	if(byteCount != 256) {
+		std::cout << "error: Exhaustive<uint8_t> generated " << byteCount << " values" << std::endl;
+		return	2;
+	}
+
+	// 途中で中断した実行を、チェックポイントから再開する。
+	const std::string	path = "protest_test_checkpoint.tmp";
+	std::remove(path.c_str());
+	{
+		protest::SimpleTest<uint16_t>	test("checkpoint", [](const uint16_t &x) -> protest::CheckResult {
+				if(x == 100) {
+					throw	std::runtime_error("interrupted");
+				}
+				return	protest::AssertResult(true, "");
+			});
+		test.checkpoint(path, std::chrono::nanoseconds::zero());
+		try {
+			test.runTest("exhaustive case", protest::case_gen::Exhaustive<uint16_t>(), 1000);
+			std::cout << "error: the test is not interrupted" << std::endl;
+			return	3;
+		} catch(const std::runtime_error &) {
+		}
+	}
+	uint16_t		firstCase = 0;
+	bool			first = true;
+	protest::SimpleTest<uint16_t>	test("checkpoint", [&firstCase, &first](const uint16_t &x) {
+			if(first) {
+				firstCase = x;
+				first = false;
+			}
+			return	protest::AssertResult(true, "");
+		});
+	test.checkpoint(path, std::chrono::nanoseconds::zero());
+	test.resume(true);
+	const auto		&result = test.runTest("exhaustive case", protest::case_gen::Exhaustive<uint16_t>(), 1000, std::cout);
+	printResult(std::cout, result);
+	if(result.isTestFailed() || (result.passCount != 1000) || (firstCase != 100)) {
+		std::cout << "error: not resumed from the checkpoint (first case: " << firstCase << ")" << std::endl;
+		return	4;
+	}
+	if(std::ifstream(path)) {
+		std::cout << "error: checkpoint is not removed" << std::endl;
+		return	5;
+	}
+	return	0;
+}
+
+int				equivalentTest(void)
+{
+	// 2ULP ずれた値を返す「高速版」。
+	const auto		shifted = [](float x) {
+			return	std::nextafter(std::nextafter(x, INFINITY), INFINITY);
+		};
+	const auto		identity = [](float x) {
+			return	x;
+		};
+	if(protest::ulpDistance(0.0f, -0.0f) || (protest::ulpDistance(-1.0f, std::nextafter(-1.0f, 0.0f)) != 1)
+			|| (protest::ulpDistance(-FLT_MIN / 2, FLT_MIN / 2) != 2 * protest::ulpDistance(0.0f, FLT_MIN / 2))) {
+		std::cout << "error: ulpDistance" << std::endl;
+		return	1;
+	}
+	protest::Equivalent<float, float, protest::compare::Ulp>	loose(shifted, identity, protest::compare::Ulp(2));
+	protest::Equivalent<float, float, protest::compare::Ulp>	tight(shifted, identity, protest::compare::Ulp(1));
+	protest::Equivalent<float, float>	exact(shifted, identity);
+	const auto		reason = tight(1.0f).reason;
+	if(loose(1.0f).reason || exact(1.0f).reason.value_or("").find("ULP distance: 2") == std::string::npos
+			|| !reason || (reason->find("fast=1.00000024") == std::string::npos)
+			|| (reason->find("reference=1 (ULP distance: 2)") == std::string::npos)) {
+		std::cout << "error: Equivalent: " << reason.value_or("(passed)") << std::endl;
+		return	2;
+	}
+	protest::EquivalentBy<int, int>	sameParity([](int x) { return x & 1; }, [](int x) { return x % 2; },
+			[](int a, int b) { return (a != 0) == (b != 0); });
+	if(sameParity(-3).reason || sameParity(4).reason) {
+		return	3;
+	}
+
+	// 配列に対するカーネル。参照実装と同じ式なら完全に一致する。
+	const auto		referenceKernel = [](const float *in, float *out, size_t n) {
+			for(size_t i = 0; i < n; ++i) {
+				out[i] = in[i] * 3.0f + 1.0f;
+			}
+		};
+	const auto		fusedKernel = [](const float *in, float *out, size_t n) {
+			for(size_t i = 0; i < n; ++i) {
+				out[i] = std::fma(in[i], 3.0f, 1.0f);
+			}
+		};
+	protest::SimpleTest<std::vector<float>>	batchTest("BatchEquivalent with ULP tolerance",
+			protest::BatchEquivalent<float, float, protest::compare::Ulp>(fusedKernel, referenceKernel, protest::compare::Ulp(1)));
+	protest::case_gen::SizedVector<float>	batches(1000, 10);
+	auto			result = batchTest.runTest("fma kernel", batches, 50, std::cout);
+	printResult(std::cout, result);
+	if(result.isTestFailed()) {
+		return	4;
+	}
+	// 600番目の要素だけ間違えるカーネル。2番目のブロックで見つかる。
+	const auto		brokenKernel = [](const int32_t *in, int32_t *out, size_t n) {
+			for(size_t i = 0; i < n; ++i) {
+				out[i] = in[i] ^ ((i == 600) ? 1 : 0);
+			}
+		};
+	const auto		intReference = [](const int32_t *in, int32_t *out, size_t n) {
+			std::copy(in, in + n, out);
+		};
+	protest::BatchEquivalent<int32_t, int32_t>	broken(brokenKernel, intReference);
+	const std::vector<int32_t>	input(1000, 6);
+	const auto		batchReason = broken(input).reason;
+	if(!batchReason || (batchReason->find("at index 600 of 1000: input=6, fast=7, reference=6") == std::string::npos)
+			|| broken(std::vector<int32_t>(600, 6)).reason) {
+		std::cout << "error: BatchEquivalent: " << batchReason.value_or("(passed)") << std::endl;
+		return	5;
+	}
+	return	0;
+}
+
+int				isaVariantTest(void)
+{
+	// 本物の SIMD 実装の代わりに、命令セットごとに別の式で同じ値を計算する。
+	// AVX-512 の変種だけ、7 に対して間違える。
+	protest::KernelVariants<int32_t(const int32_t &)>	triple;
+	triple.add(protest::IsaLevel::Scalar, [](int32_t x) { return x * 3; })
+		.add(protest::IsaLevel::Sse42, [](int32_t x) { return x + x + x; })
+		.add(protest::IsaLevel::Avx2, [](int32_t x) { return x * 2 + x; })
+		.add(protest::IsaLevel::Avx512, [](int32_t x) { return x * 3 + (x == 7); });
+	protest::AcrossVariants<int32_t, int32_t>	cond(triple);
+	const bool		hasAvx512 = protest::isaSupported(protest::IsaLevel::Avx512);
+	const auto		reason = cond(7).reason;
+	if(cond(6).reason || (hasAvx512 != static_cast<bool>(reason))
+			|| (hasAvx512 && (*reason != "AVX-512 differs from scalar: scalar=21, AVX-512=22"))
+			|| (hasAvx512 == (std::find(cond.skipped().begin(), cond.skipped().end(), protest::IsaLevel::Avx512) != cond.skipped().end()))) {
+		std::cout << "error: AcrossVariants: " << reason.value_or("(passed)") << std::endl;
+		return	1;
+	}
+
+	protest::KernelVariants<void(const float *, float *, size_t)>	halves;
+	halves.add(protest::IsaLevel::Scalar, [](const float *in, float *out, size_t n) {
+			for(size_t i = 0; i < n; ++i) {
+				out[i] = in[i] / 2.0f;
+			}
+		})
+		.add(protest::IsaLevel::Avx2, [](const float *in, float *out, size_t n) {
+			for(size_t i = 0; i < n; ++i) {
+				out[i] = in[i] * 0.5f;
+			}
+		});
+	protest::BatchAcrossVariants<float, float>	batchCond(halves);
+	protest::SimpleTest<std::vector<float>>	batchTest("BatchAcrossVariants", batchCond);
+	protest::case_gen::SizedVector<float>	batches(1000, 10);
+	auto			result = batchTest.runTest("halves", batches, 50, std::cout);
+	printResult(std::cout, result);
+	for(const auto level : batchCond.skipped()) {
+		std::cout << "skipped: " << protest::isaName(level) << std::endl;
+	}
+	if(result.isTestFailed()) {
+		return	2;
+	}
+	return	0;
+}
+
+int				bulkConditionTest(void)
+{
+	const auto		sortCopy = [](const std::vector<int32_t> &v) {
+			auto			ret = v;
+			std::sort(ret.begin(), ret.end());
+			return	ret;
+		};
+	// 末尾の要素を一つ捨てて、代わりに先頭を複製してしまう。
+	const auto		lossySort = [sortCopy](const std::vector<int32_t> &v) {
+			auto			ret = sortCopy(v);
+			if(ret.size() > 1) {
+				ret.back() = ret.front();
+				std::sort(ret.begin(), ret.end());
+			}
+			return	ret;
+		};
+	protest::SimpleTest<std::vector<int32_t>>	sortTest("BulkSorted and PermutationOf",
+			[sorted=protest::BulkSorted<std::vector<int32_t>>(sortCopy), permutation=protest::PermutationOf<std::vector<int32_t>>(sortCopy)]
+			(const std::vector<int32_t> &v) mutable {
+				auto			ret = sorted(v);
+				return	ret.reason ? ret : permutation(v);
+			});
+	protest::case_gen::SizedVector<int32_t>	vectors(10000, 20);
+	auto			result = sortTest.runTest("random vectors", vectors, 30, std::cout);
+	printResult(std::cout, result);
+	if(result.isTestFailed()) {
+		return	1;
+	}
+	const std::vector<int32_t>	input = {3, 1, 2, 2};
+	const auto		lostReason = protest::PermutationOf<std::vector<int32_t>>(lossySort)(input).reason;
+	const auto		unsortedReason = protest::BulkSorted<std::vector<int32_t>>()(input).reason;
+	if(!lostReason || (*lostReason != "output is not a permutation of the input: value 1 occurs 1 times in the input and 2 times in the output")
+			|| !unsortedReason || (*unsortedReason != "not ascending at index 0: 3, 1")) {
+		std::cout << "error: " << lostReason.value_or("(passed)") << " / " << unsortedReason.value_or("(passed)") << std::endl;
+		return	2;
+	}
+
+	// ブロック(256要素)をまたいだ位置の違反も見つける。
+	std::vector<float>	values(1000, 0.5f);
+	protest::AllFinite<std::vector<float>>	finite;
+	protest::Bounded<std::vector<float>>	unit(0.0f, 1.0f);
+	protest::Monotone<std::vector<float>>	strict(protest::bulk::Order::StrictlyDescending);
+	if(finite(values).reason || unit(values).reason || !strict(values).reason) {
+		return	3;
+	}
+	values[700] = NAN;
+	const auto		nanReason = finite(values).reason;
+	values[700] = 2.0f;
+	const auto		rangeReason = unit(values).reason;
+	if(!nanReason || (*nanReason != "element 700 is not finite: nan") || !rangeReason
+			|| (*rangeReason != "element 700 is out of [0, 1]: 2") || finite(values).reason) {
+		std::cout << "error: " << nanReason.value_or("(passed)") << " / " << rangeReason.value_or("(passed)") << std::endl;
+		return	4;
+	}
+	std::vector<int16_t>	countdown(600);
+	for(size_t i = 0; i < countdown.size(); ++i) {
+		countdown[i] = static_cast<int16_t>(600 - i);
+	}
+	protest::Monotone<std::vector<int16_t>>	strictShort(protest::bulk::Order::StrictlyDescending);
+	if(strictShort(countdown).reason) {
+		return	5;
+	}
+	countdown[300] = countdown[299];
+	if(strictShort(countdown).reason.value_or("") != "not strictly descending at index 299: 301, 301") {
+		return	6;
+	}
+	// 上位と下位の32ビットを畳み込むと一致してしまう64ビットの値も区別する。
+	const uint64_t	lowOnly = 0x9e3779b9u;
+	const uint64_t	highOnly = static_cast<uint64_t>(1) << 32;
+	if(protest::bulk::multisetHash(&lowOnly, 1) == protest::bulk::multisetHash(&highOnly, 1)) {
+		std::cout << "error: multisetHash() folds 64-bit elements" << std::endl;
+		return	7;
+	}
+	return	0;
+}
+
+int				batchPropertyTest(void)
+{
+	// 1500 だけで失敗する性質。 1500 は2番目のバッチの476番目。
+	std::vector<int32_t>	inputs(3000);
+	for(size_t i = 0; i < inputs.size(); ++i) {
+		inputs[i] = static_cast<int32_t>(i);
+	}
+	protest::SimpleTest<int32_t>	laneTest("batch property reports the failing lane",
+			[](protest::Span<const int32_t> in, protest::Span<uint8_t> failed) {
+				for(size_t i = 0; i < in.size(); ++i) {
+					failed[i] = (in[i] == 1500);
+				}
+			});
+	auto			result = laneTest.runTest("sequential case", protest::case_gen::IterableSource<std::vector<int32_t>>(inputs), 10000);
+	printResult(std::cout, result);
+	if(!result.isTestFailed() || (protest::case_cast<int32_t>(result.failedCase) != 1500) || (result.passCount != 1500)
+			|| (result.reason.value() != "failed at lane 476 of a batch of 1024")) {
+		std::cout << "error: failing lane is not reported" << std::endl;
+		return	1;
+	}
+
+	// 事前条件を満たさないケースはバッチに入らない。
+	using	Nums = std::tuple<int8_t, int16_t, int32_t, float, double>;
+	auto			seqResult = protest::generic::test<protest::generic::Random, Nums>(
+			"absolute<>() batch positivity test"
+			, "random case"
+			, [](auto in, auto failed) {
+				for(size_t i = 0; i < in.size(); ++i) {
+					failed[i] = (absolute(in[i]) < 0);
+				}
+			}
+			, [](auto x) {
+				return	std::numeric_limits<decltype(x)>::lowest() < x;
+			}
+			, 5000, std::cout
+		);
+	if(seqResult.result.isTestFailed() || (seqResult.result.passCount != 5000)) {
+		return	2;
+	}
+	return	0;
+}
+
+int				snapshotTest(void)
+{
+	const std::string	path = "protest_test_snapshot.tmp";
+	const std::string	indexPath = protest::detail::snapshotIndexPath(path);
+	std::remove(path.c_str());
+	std::remove(indexPath.c_str());
+	std::string		output(64 * 1024, '\0');
+	for(size_t i = 0; i < output.size(); ++i) {
+		output[i] = static_cast<char>(i * 7 + (i >> 8));
+	}
+	protest::SnapshotOptions	options;
+	options.chunkSize = 4096;
+	options.mode = protest::SnapshotMode::Compare;
+	if(!protest::checkSnapshot(path, output, options).reason) {
+		std::cout << "error: missing golden file is accepted" << std::endl;
+		return	1;
+	}
+	// 更新モードでゴールデンファイルと索引を作る。
+	options.mode = protest::SnapshotMode::Update;
+	protest::MatchesSnapshot<int32_t>	snapshot(path, [&output](int32_t) { return output; }, options);
+	if(snapshot(0).reason || !std::ifstream(indexPath)) {
+		std::cout << "error: golden file is not written" << std::endl;
+		return	2;
+	}
+	options.mode = protest::SnapshotMode::Compare;
+	if(auto reason = protest::checkSnapshot(path, output, options).reason) {
+		std::cout << "error: " << reason.value() << std::endl;
+		return	3;
+	}
+	// 2つのチャンクを書き換えると、その領域だけが報告される。
+	std::string		changed = output;
+	changed[5000] = static_cast<char>(~changed[5000]);
+	changed[5003] = static_cast<char>(~changed[5003]);
+	changed[40000] = static_cast<char>(~changed[40000]);
+	auto			result = protest::checkSnapshot(path, changed, options);
+	if(!result.reason || (result.reason.value().find("bytes 5000..5003 (chunk 1)") == std::string::npos)
+			|| (result.reason.value().find("bytes 40000..40000 (chunk 9)") == std::string::npos)
+			|| (result.reason.value().find("chunk 2)") != std::string::npos)) {
+		std::cout << "error: differing regions are not reported: " << result.reason.value_or("") << std::endl;
+		return	4;
+	}
+	// 索引が無くても、ゴールデンファイルから作り直して比べる。
+	std::remove(indexPath.c_str());
+	options.chunkSize = 1000;
+	changed = output;
+	changed.resize(output.size() - 1);
+	result = protest::checkSnapshot(path, changed, options);
+	if(!result.reason || (result.reason.value().find("size differs: golden=65536, actual=65535") == std::string::npos)
+			|| (result.reason.value().find("bytes") != std::string::npos) || !std::ifstream(indexPath)) {
+		std::cout << "error: size difference: " << result.reason.value_or("") << std::endl;
+		return	5;
+	}
+	// チャンクの大きさが0なら、割り算や無限ループにならずに失敗する。
+	options.chunkSize = 0;
+	result = protest::checkSnapshot(path, output, options);
+	if(!result.reason || (result.reason.value().find("chunk size") == std::string::npos)) {
+		std::cout << "error: zero chunk size is accepted: " << result.reason.value_or("") << std::endl;
+		return	6;
+	}
+	std::remove(path.c_str());
+	std::remove(indexPath.c_str());
+	return	0;
+}
+
+int				fuzzTest(void)
+{
+	protest::case_gen::Fuzz<std::string>	fuzz(std::string(), 64);
+	fuzz.addSeed("seed");
+	fuzz.addSeed("");
+	protest::SimpleTest<std::string>	test(
+			"Length bound test for case_gen::Fuzz<std::string>",
+			[](const std::string &arg) {
+				return	protest::AssertResult(arg.size() <= 64, "generated case is longer than the limit");
+			}
+		);
+	auto			result = test.runTest(
+			"fuzzed case",
+			fuzz,
+			1000,
+			std::cout);
+	printResult(std::cout, result);
+	if(result.isTestFailed() || (result.passCount != 1000)) {
+		return	1;
+	}
+
+	// 2つのエッジを持つ計装の代わり。先頭が 'A' のケースだけが2つ目のエッジを通る。
+	static uint32_t	guards[2];
+	__sanitizer_cov_trace_pc_guard_init(guards, guards + 2);
+	protest::coverage::clearCounters();
+	const std::string	corpusDir = "protest_test_fuzz_corpus.tmp";
+	const auto		removeCorpus = [&corpusDir]() {
+			if(DIR *d = opendir(corpusDir.c_str())) {
+				while(dirent *ent = readdir(d)) {
+					if(ent->d_name[0] != '.') {
+						std::remove((corpusDir + '/' + ent->d_name).c_str());
+					}
+				}
+				closedir(d);
+				rmdir(corpusDir.c_str());
+			}
+		};
+	removeCorpus();
+	protest::case_gen::Fuzz<std::vector<uint8_t>>	bytes(corpusDir, 16);
+	bytes.addSeed(std::vector<uint8_t>());
+	bytes.addSeed(std::vector<uint8_t>{'A'});
+	protest::SimpleTest<std::vector<uint8_t>>	coverageTest(
+			"New coverage is kept in the corpus",
+			[](const std::vector<uint8_t> &arg) {
+				__sanitizer_cov_trace_pc_guard(&guards[0]);
+				if(!arg.empty() && (arg[0] == 'A')) {
+					__sanitizer_cov_trace_pc_guard(&guards[1]);
+				}
+				return	protest::AssertResult(true, "");
+			}
+		);
+	result = coverageTest.runTest("fuzzed bytes", bytes, 100, std::cout);
+	// 2つのシードがそれぞれ新しいエッジを通るので、ディレクトリに書かれる。コーパスには二重に加えない。
+	auto			stored = protest::coverage::loadCorpus(corpusDir);
+	std::sort(stored.begin(), stored.end());
+	if(result.isTestFailed() || (bytes.corpusSize() != 2) || (stored != std::vector<std::string>{"", "A"})) {
+		std::cout << "error: new coverage is not kept: corpus size " << bytes.corpusSize() << ", stored " << stored.size() << std::endl;
+		removeCorpus();
+		return	2;
+	}
+	// 書いたコーパスを読み直すと、同じケースから始まる。
+	protest::case_gen::Fuzz<std::vector<uint8_t>>	reloaded(corpusDir, 16);
+	std::vector<std::vector<uint8_t>>	replayed;
+	for(size_t i = 0; i < reloaded.corpusSize(); ++i) {
+		replayed.push_back(reloaded().value());
+	}
+	std::sort(replayed.begin(), replayed.end());
+	removeCorpus();
+	if(replayed != std::vector<std::vector<uint8_t>>{std::vector<uint8_t>(), std::vector<uint8_t>{'A'}}) {
+		std::cout << "error: corpus does not round-trip" << std::endl;
+		return	3;
+	}
+	return	0;
+}
+
+int				sizedTest(void)
+{
+	protest::SimpleTest<std::vector<int32_t>>	test(
+			"Size bound test for case_gen::SizedVector<int32_t>",
+			[](const std::vector<int32_t> &arg) {
+				return	protest::AssertResult(arg.size() <= 1000, "generated case is longer than the limit");
+			}
+		);
+	auto			result = test.runTest(
+			"sized case",
+			protest::case_gen::SizedVector<int32_t>(1000, 100),
+			500,
+			std::cout);
+	printResult(std::cout, result);
+	if(result.isTestFailed()) {
+		return	1;
+	}
+	// 長さの上限はスケジュールに従って大きくなり、使い終わったバッファは次のケースで再利用される。
+	std::vector<size_t>	sizes, capacities;
+	protest::SimpleTest<std::vector<int32_t>>	recordTest(
+			"Schedule and buffer reuse of case_gen::SizedVector<int32_t>",
+			[&sizes, &capacities](const std::vector<int32_t> &arg) {
+				sizes.push_back(arg.size());
+				capacities.push_back(arg.capacity());
+				return	protest::AssertResult(true, "");
+			}
+		);
+	result = recordTest.runTest("sized case", protest::case_gen::SizedVector<int32_t>(1000, 100), 500, std::cout);
+	if(result.isTestFailed() || (sizes.size() != 500)) {
+		printResult(std::cout, result);
+		return	3;
+	}
+	size_t			lateMax = 0;
+	for(size_t i = 0; i < sizes.size(); ++i) {
+		if(sizes[i] > std::min<size_t>(1000, 1000 * (i + 1) / 100)) {
+			std::cout << "error: case " << i << " of size " << sizes[i] << " exceeds the schedule" << std::endl;
+			return	4;
+		}
+		if(i >= 100) {
+			lateMax = std::max(lateMax, sizes[i]);
+		}
+		// 新しく確保したバッファなら、短いケースで容量が減る。
+		if(i && (capacities[i] < capacities[i - 1])) {
+			std::cout << "error: buffer of case " << (i - 1) << " is not reused" << std::endl;
+			return	5;
+		}
+	}
+	if(lateMax < 900) {
+		std::cout << "error: sizes do not grow to the maximum: " << lateMax << std::endl;
+		return	6;
+	}
+	// 固定長での生成。
+	protest::case_gen::SizedString<>	gen;
+	if(gen.generate(42).size() != 42) {
+		std::cout << "error: SizedString::generate() returned wrong length" << std::endl;
+		return	2;
+	}
+	return	0;
+}
+
+int				asyncTest(void)
+{
+	protest::AsyncTest<int>	test(
+			"First failure test for AsyncTest",
+			[](const int &arg) {
+				return	std::async(std::launch::async, [x = arg]() {
+						// 後に生成されたケースほど早く終わるようにする。
+						std::this_thread::sleep_for(std::chrono::microseconds(100 * (x % 8)));
+						return	protest::AssertResult((x != 37) && (x != 38), "failure");
+					});
+			}
+		);
+	test.maxInFlight(8);
+	int				next = 0;
+	auto			result = test.runTest(
+			"counting case",
+			[&next]() { return	protest::ns_optional::optional<int>(next++); },
+			1000,
+			std::cout);
+	if((protest::case_cast<int>(result.failedCase) != 37) || (result.passCount != 37)) {
+		std::cout << "error: AsyncTest did not report the first failure" << std::endl;
+		return	1;
+	}
+	return	0;
+}
+
+int				timeoutTest(void)
+{
+	protest::SimpleTest<int>	test(
+			"Timeout test for SimpleTest",
+			[](const int &arg) {
+				// 一つのケースだけが止まる。
+				std::this_thread::sleep_for(std::chrono::milliseconds((arg == 7) ? 2000 : (arg % 3) * 20));
+				return	protest::AssertResult(true, "");
+			}
+		);
+	test.timeout(std::chrono::milliseconds(100));
+	test.recordSlowest(3);
+	int				next = 0;
+	const auto		startTime = std::chrono::steady_clock::now();
+	auto			result = test.runTest(
+			"counting case",
+			[&next]() { return	protest::ns_optional::optional<int>(next++); },
+			100,
+			std::cout);
+	if((std::chrono::steady_clock::now() - startTime) >= std::chrono::seconds(1)) {
+		std::cout << "error: SimpleTest waited for the hanging case" << std::endl;
+		return	1;
+	}
+	if((protest::case_cast<int>(result.failedCase) != 7) || (result.passCount != 7)) {
+		std::cout << "error: SimpleTest did not report the hanging case" << std::endl;
+		return	2;
+	}
+	const auto		&slowest = result.slowestCases;
+	if((slowest.size() != 3) || (slowest[0].elapsed < slowest[2].elapsed)
+			|| (protest::case_cast<int>(slowest[0].testCase) % 3 != 2)) {
+		std::cout << "error: slowest cases are not recorded" << std::endl;
+		return	3;
+	}
+
+	// 中央値の2000倍より時間のかかったケースは、性質が成功していても失敗とする。
+	// 閾値(200ms)は、負荷の高いマシンでケースが横取りされる時間より十分長くしておく。
+	protest::SimpleTest<int>	outlierTest(
+			"Outlier case for SimpleTest",
+			[](const int &arg) {
+				const auto		until = std::chrono::steady_clock::now() + std::chrono::microseconds((arg == 200) ? 1000000 : 100);
+				while(std::chrono::steady_clock::now() < until) {
+				}
+				return	protest::AssertResult(true, "");
+			}
+		);
+	outlierTest.slowCaseFactor(2000);
+	next = 0;
+	const auto		&outlier = outlierTest.runTest(
+			"counting case",
+			[&next]() { return	protest::ns_optional::optional<int>(next++); },
+			1000);
+	if((protest::case_cast<int>(outlier.failedCase) != 200) || (outlier.passCount != 200)
+			|| (outlier.reason.value().find("times the median") == std::string::npos)) {
+		printResult(std::cout, outlier);
+		std::cout << "error: SimpleTest did not report the outlier case" << std::endl;
+		return	7;
+	}
+
+	// 放棄されたケースがまだアリーナを使っている間に、ムーブしたテストを再び実行する。
+	std::atomic<int>	calls(0);
+	std::atomic<bool>	overwritten(false);
+	protest::SimpleTest<protest::ArenaVector<int32_t>>	abandoning(
+			"Arena outlives the abandoned case",
+			[&calls, &overwritten](const protest::ArenaVector<int32_t> &arg) {
+				if(calls++ == 0) {
+					const std::vector<int32_t>	before(arg.begin(), arg.end());
+					std::this_thread::sleep_for(std::chrono::milliseconds(300));
+					overwritten = !std::equal(before.begin(), before.end(), arg.begin(), arg.end());
+				}
+				return	protest::AssertResult(true, "");
+			}
+		);
+	abandoning.timeout(std::chrono::milliseconds(50));
+	if(!abandoning.runTest("arena case", protest::case_gen::ArenaSizedVector<int32_t>(64, 1), 10).isTestFailed()) {
+		std::cout << "error: SimpleTest did not abandon the hanging case" << std::endl;
+		return	4;
+	}
+	abandoning.clearAll();
+	auto			moved = std::move(abandoning);
+	if(moved.runTest("arena case", protest::case_gen::ArenaSizedVector<int32_t>(64, 1), 1000).isTestFailed()) {
+		return	5;
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(400));
+	if(overwritten) {
+		std::cout << "error: the arena was reused while the abandoned case used it" << std::endl;
+		return	6;
+	}
+	return	0;
+}
+
+int				perfConditionTest(void)
+{
+	const auto		sumUpTo = [](const size_t &n) {
+			uint64_t		sum = 0;
+			for(size_t i = 0; i < n; ++i) {
+				sum += i * i;
+				protest::detail::keep(sum);
+			}
+			return	sum;
+		};
+	const auto		gen = []() { return	protest::ns_optional::optional<size_t>(1000); };
+	protest::SimpleTest<size_t>	within(
+			"Loose latency budget",
+			protest::WithinLatency<size_t>(sumUpTo, std::chrono::seconds(1)));
+	if(within.runTest("n=1000", gen, 3).isTestFailed()) {
+		return	1;
+	}
+	protest::SimpleTest<size_t>	exceed(
+			"Impossible latency budget",
+			protest::WithinLatency<size_t>(sumUpTo, std::chrono::nanoseconds(1)));
+	const auto		&result = exceed.runTest("n=1000", gen, 3);
+	if(!result.isTestFailed() || (result.reason.value().find("exceeds the budget 1ns") == std::string::npos)) {
+		std::cout << "error: WithinLatency did not fail" << std::endl;
+		return	2;
+	}
+	const auto		sumUpTo100Times = [&sumUpTo](const size_t &n) { return	sumUpTo(n * 100); };
+	protest::SimpleTest<size_t>	faster(
+			"Faster than a slower function",
+			protest::FasterThan<size_t>(sumUpTo, sumUpTo100Times, 0.5));
+	if(faster.runTest("n=1000", gen, 3).isTestFailed()) {
+		std::cout << "error: FasterThan failed" << std::endl;
+		return	3;
+	}
+	protest::SimpleTest<size_t>	slower(
+			"Faster than a faster function",
+			protest::FasterThan<size_t>(sumUpTo100Times, sumUpTo));
+	if(!slower.runTest("n=1000", gen, 3).isTestFailed()) {
+		std::cout << "error: FasterThan did not fail" << std::endl;
+		return	4;
+	}
+	// n=100 の95%信頼区間は、1始まりで40番目と61番目の標本。
+	std::vector<double>	samples;
+	for(int i = 100; i > 0; --i) {
+		samples.push_back(i);
+	}
+	protest::PerfOptions	opts;
+	opts.outlierThreshold = 0.0;
+	const auto		summary = protest::detail::summarizeSamples(samples, opts);
+	if((static_cast<int>(summary.median * 2.0) != 101) || (static_cast<int>(summary.lower) != 40) || (static_cast<int>(summary.upper) != 61)) {
+		std::cout << "error: wrong confidence interval [" << summary.lower << ", " << summary.upper << "]" << std::endl;
+		return	5;
+	}
+	// 粗い時計で同じ値が並び MAD が0でも、捨てるのはスパイクだけ。
+	std::vector<double>	spiky(10, 100.0);
+	spiky.push_back(101.0);
+	spiky.push_back(1000.0);
+	spiky.push_back(1200.0);
+	const auto		spikySummary = protest::detail::summarizeSamples(spiky, protest::PerfOptions());
+	if((spikySummary.rejected != 2) || (spikySummary.samples != 11) || (static_cast<int>(spikySummary.median) != 100)) {
+		std::cout << "error: outliers of constant samples: rejected " << spikySummary.rejected << std::endl;
+		return	6;
+	}
+	return	0;
+}
+
+int				complexityTest(void)
+{
+	protest::ComplexityOptions	opts;
+	opts.minSize = 256;
+	opts.maxSize = 4096;
+	opts.casesPerSize = 1;
+	const auto		sum = [](const std::vector<int32_t> &v) {
+			int64_t			s = 0;
+			for(auto x : v) {
+				s += x;
+				protest::detail::keep(s);
+			}
+			return	s;
+		};
+	// 小さな入力では要素あたりの時間が短く、わずかに線形より悪く見えるので、大きめの入力で測る。
+	protest::ComplexityOptions	linearOpts = opts;
+	linearOpts.minSize = 1024;
+	linearOpts.maxSize = 16384;
+	protest::ComplexityTest<std::vector<int32_t>>	linear("Linear sum", sum, protest::Complexity::Linear, linearOpts);
+	auto			result = linear.runTest("sized vector", protest::case_gen::SizedVector<int32_t>());
+	if(result.isTestFailed() || (result.complexity.series.size() != 5)) {
+		printResult(std::cout, result);
+		return	1;
+	}
+	const auto		pairCount = [](const std::vector<int32_t> &v) {
+			size_t			c = 0;
+			for(size_t i = 0; i < v.size(); ++i) {
+				for(size_t j = 0; j < v.size(); ++j) {
+					c += (v[i] < v[j]);
+					protest::detail::keep(c);
+				}
+			}
+			return	c;
+		};
+	protest::ComplexityTest<std::vector<int32_t>>	quadratic("Quadratic pair count", pairCount, protest::Complexity::NLogN, opts);
+	result = quadratic.runTest("sized vector", protest::case_gen::SizedVector<int32_t>());
+	if(!result.isTestFailed() || (result.complexity.bestFit != "O(n^2)")) {
+		std::cout << "error: quadratic function is not detected" << std::endl;
+		printResult(std::cout, result);
+		return	2;
+	}
+	// 大きな固定のオーバーヘッドがあっても、線形な部分を見つける。
+	std::vector<protest::SizeTiming>	series;
+	for(size_t n = 256; n <= 4096; n *= 2) {
+		series.push_back(protest::SizeTiming{n, std::chrono::nanoseconds(20000 + 10 * n)});
+	}
+	const auto		fit = protest::fitComplexity(series);
+	if((fit.bestFit != protest::Complexity::Linear) || (std::fabs(fit.intercept - 20000.0) > 1.0)) {
+		std::cout << "error: overhead is not separated: " << protest::complexityName(fit.bestFit) << std::endl;
+		return	3;
+	}
+	// O(n log n) は O(n) と rms の差が小さいが、最良との比で見分ける。
+	series.clear();
+	for(size_t n = 256; n <= 4096; n *= 2) {
+		const double	nlogn = static_cast<double>(n) * std::log2(static_cast<double>(n));
+		series.push_back(protest::SizeTiming{n, std::chrono::nanoseconds(100 + static_cast<int64_t>(nlogn))});
+	}
+	if(protest::fitComplexity(series).bestFit != protest::Complexity::NLogN) {
+		std::cout << "error: n log n timings are not detected: " << protest::complexityName(protest::fitComplexity(series).bestFit) << std::endl;
+		return	4;
+	}
+	// 線形と宣言した関数が n log n の時間をかけると失敗する。
+	const auto		nLogNLoop = [](const std::vector<int32_t> &v) {
+			const size_t	n = v.size();
+			const size_t	steps = n * static_cast<size_t>(std::log2(static_cast<double>(n)));
+			int64_t			s = 0;
+			for(size_t i = 0; i < steps; ++i) {
+				s += v[i % n];
+				protest::detail::keep(s);
+			}
+			return	s;
+		};
+	protest::ComplexityOptions	wideOpts = opts;
+	wideOpts.minSize = 16;
+	wideOpts.maxSize = 65536;
+	protest::ComplexityTest<std::vector<int32_t>>	nLogN("n log n loop declared linear", nLogNLoop, protest::Complexity::Linear, wideOpts);
+	result = nLogN.runTest("sized vector", protest::case_gen::SizedVector<int32_t>());
+	if(!result.isTestFailed() || (result.complexity.bestFit != "O(n log n)")) {
+		std::cout << "error: n log n function passes the linear bound" << std::endl;
+		printResult(std::cout, result);
+		return	5;
+	}
+	return	0;
+}
+
+int				allocTest(void)
+{
+	if(!protest::alloc_tracker::available()) {
+		std::cout << "error: allocation tracker is not linked" << std::endl;
+		return	1;
+	}
+	protest::case_gen::SizedVector<int32_t>	gen(100, 10);
+	protest::SimpleTest<std::vector<int32_t>>	sumTest(
+			"No allocation in sum",
+			protest::NoAllocation<std::vector<int32_t>>([](const std::vector<int32_t> &v) {
+				int64_t			s = 0;
+				for(auto x : v) {
+					s += x;
+				}
+				return	s;
+			}));
+	if(sumTest.runTest("sized vector", gen, 100).isTestFailed()) {
+		return	2;
+	}
+	protest::SimpleTest<std::vector<int32_t>>	copyTest(
+			"No allocation in copy",
+			protest::NoAllocation<std::vector<int32_t>>([](const std::vector<int32_t> &v) {
+				return	std::vector<int32_t>(v);
+			}));
+	const auto		&result = copyTest.runTest("sized vector", gen, 100);
+	// 空のベクタのコピーは確保しないので、空でない最初のケースで失敗する。
+	if(!result.isTestFailed() || protest::case_cast<std::vector<int32_t>>(result.failedCase).empty()
+			|| (result.reason.value().find("1 allocations") != 0)) {
+		std::cout << "error: NoAllocation did not detect the allocation" << std::endl;
+		return	3;
+	}
+	protest::SimpleTest<std::vector<int32_t>>	atMostTest(
+			"At most one allocation in copy",
+			protest::AllocatesAtMost<std::vector<int32_t>>([](const std::vector<int32_t> &v) {
+				return	std::vector<int32_t>(v);
+			}, 1));
+	if(atMostTest.runTest("sized vector", gen, 100).isTestFailed()) {
+		return	4;
+	}
+#if defined(__cpp_aligned_new) && __cpp_aligned_new
+	// 過剰アライメントの確保も数える。
+	struct alignas(64)	CacheLine {
+		char			bytes[64];
+	};
+	protest::SimpleTest<int>	alignedTest(
+			"Over-aligned allocation is tracked",
+			protest::AllocatesAtMost<int>([](const int &n) {
+				std::unique_ptr<CacheLine[]>	lines(new CacheLine[n + 1]);
+				std::unique_ptr<CacheLine>	line(new CacheLine());
+				// 対になった new と delete が省かれないようにする。
+				protest::detail::keep(lines.get());
+				protest::detail::keep(line.get());
+			}, 1));
+	const auto		&aligned = alignedTest.runTest("small int", []() { return	protest::ns_optional::optional<int>(3); }, 1);
+	if(!aligned.isTestFailed() || (aligned.reason.value().find("2 allocations") != 0)) {
+		std::cout << "error: over-aligned allocations are not tracked: " << aligned.reason.value_or("passed") << std::endl;
+		return	5;
+	}
+	std::unique_ptr<CacheLine>	line(new CacheLine());
+	if(reinterpret_cast<uintptr_t>(line.get()) % alignof(CacheLine)) {
+		std::cout << "error: over-aligned allocation is not aligned" << std::endl;
+		return	6;
+	}
+#endif
+	return	0;
+}
+
+int				perfCounterTest(void)
+{
+	protest::SimpleTest<std::vector<int32_t>>	test(
+			"Performance counters around the check",
+			[](const std::vector<int32_t> &v) {
+				std::vector<int32_t>	sorted(v);
+				std::sort(sorted.begin(), sorted.end());
+				return	protest::AssertResult(std::is_sorted(sorted.begin(), sorted.end()), "not sorted");
+			});
+	test.countPerfEvents(true);
+	const auto		&result = test.runTest("sized vector", protest::case_gen::SizedVector<int32_t>(10000, 10), 100);
+	// どのカウンタが使えても、実行時間とページフォルトは計測できる。
+	if(result.isTestFailed() || !result.counters.has(protest::PerfCounts::TaskClock)
+			|| !result.counters.get(protest::PerfCounts::TaskClock) || !result.counters.has(protest::PerfCounts::PageFaults)) {
+		printResult(std::cout, result);
+		return	1;
+	}
+	// ハードウェアカウンタが使える環境では、それも計測される。
+	protest::PerfCounterGroup	group;
+	if((group.open() == protest::PerfCounterGroup::Source::Hardware)
+			&& !(result.counters.has(protest::PerfCounts::Cycles) && result.counters.get(protest::PerfCounts::Cycles))) {
+		std::cout << "error: hardware counters are opened but not counted" << std::endl;
+		return	2;
+	}
+	return	0;
+}
+
+int				reporterTest(void)
+{
+	protest::TestResult	result;
+	result.abstract = "reporter \"test\"";
+	result.lastCaseDescription = "a<b";
+	result.passCount = 12;
+	result.skipCount = 3;
+	result.elapsed = std::chrono::microseconds(1500);
+	result.failedCase = 42;
+	result.reason.emplace("line1\nline2");
+
+	std::ostringstream	json;
+	protest::JsonLinesReporter(json).report(result);
+	if(json.str() != "{\"abstract\":\"reporter \\\"test\\\"\",\"case\":\"a<b\",\"status\":\"fail\",\"pass\":12,\"skip\":3,\"elapsed_ns\":1500000,\"reason\":\"line1\\nline2\"}\n") {
+		std::cout << "error: unexpected JSON Lines output: " << json.str() << std::endl;
+		return	1;
+	}
+
+	std::ostringstream	xml;
+	protest::JUnitXmlReporter	junit(xml);
+	junit.begin();
+	junit.report(result);
+	result.clearError();
+	junit.report(result);
+	junit.end();
+	if(xml.str().find("<testcase name=\"reporter &quot;test&quot;\" classname=\"a&lt;b\" time=\"0.001500000\" assertions=\"12\">") == std::string::npos) {
+		std::cout << "error: unexpected JUnit XML output: " << xml.str() << std::endl;
+		return	2;
+	}
+	// 件数は testsuite要素の末尾に書かれる。
+	if(xml.str().find("    <property name=\"tests\" value=\"2\"/>\n    <property name=\"failures\" value=\"1\"/>\n"
+			"    <property name=\"errors\" value=\"0\"/>\n  </properties>\n</testsuite>\n") == std::string::npos) {
+		std::cout << "error: JUnit XML summary is not written: " << xml.str() << std::endl;
+		return	3;
+	}
+
+	// 出力しないストリームは、書き込んでも状態が変わらず、どのスレッドのものでも区別できる。
+	protest::nullOstream() << std::setw(8) << 42 << "discarded" << std::endl;
+	std::ostream	&mine = protest::nullOstream();
+	bool			otherAvailable = true;
+	std::thread([&mine, &otherAvailable]() {
+			otherAvailable = protest::isOstreamAvailable(mine) || (&mine == &protest::nullOstream());
+		}).join();
+	if(!mine.good() || protest::isOstreamAvailable(mine) || otherAvailable || !protest::isOstreamAvailable(std::cout)) {
+		std::cout << "error: nullOstream() is not a discarding stream" << std::endl;
+		return	4;
+	}
+	return	0;
+}
+
+int				runnerTest(void)
+{
+	protest::TestRegistry	registry;
+	size_t			runCount = 0;
+	for(const char *name : {"absolute/int8", "absolute/int64", "sort/vector", "sort/list"}) {
+		registry.add(name, [&runCount](protest::TestContext &ctx) {
+				++runCount;
+				protest::TestResult	result;
+				result.abstract = "dummy";
+				ctx.report(result);
+			});
+	}
+	auto			names = [&registry](std::vector<std::string> filters, size_t index, size_t count) {
+			protest::RunnerOptions	opts;
+			opts.filters = std::move(filters);
+			opts.shardIndex = index;
+			opts.shardCount = count;
+			std::string		ret;
+			for(const auto *test : protest::selectTests(registry, opts)) {
+				ret += test->name + ' ';
+			}
+			return	ret;
+		};
+	if(names({"absolute/*"}, 0, 1) != "absolute/int8 absolute/int64 ") {
+		std::cout << "error: positive filter" << std::endl;
+		return	1;
+	}
+	if(names({"*", "-*/int?"}, 0, 1) != "absolute/int64 sort/vector sort/list ") {
+		std::cout << "error: negative filter" << std::endl;
+		return	2;
+	}
+	if((names({}, 0, 2) != "absolute/int8 sort/vector ") || (names({}, 1, 2) != "absolute/int64 sort/list ")) {
+		std::cout << "error: sharding" << std::endl;
+		return	3;
+	}
+	protest::RunnerOptions	opts;
+	opts.filters.push_back("sort/*");
+	std::ostringstream	oss;
+	if((protest::runTests(registry, opts, oss) != 0) || (runCount != 2)) {
+		std::cout << "error: runTests" << std::endl;
+		return	4;
+	}
+	// 並列に実行しても、出力は登録順になる。後に登録したものほど早く終わるようにしておく。
+	protest::TestRegistry	parallelRegistry;
+	std::atomic<size_t>	parallelCount(0);
+	for(size_t i = 0; i < 8; ++i) {
+		parallelRegistry.add("parallel/" + std::to_string(i), [i, &parallelCount](protest::TestContext &ctx) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(5 * (8 - i)));
+				++parallelCount;
+				ctx.out() << "test " << i << '\n';
+			}, std::chrono::milliseconds(5 * (8 - i)));
+	}
+	protest::RunnerOptions	parallelOpts;
+	parallelOpts.jobs = 4;
+	std::ostringstream	parallelOut;
+	if((protest::runTests(parallelRegistry, parallelOpts, parallelOut) != 0) || (parallelCount != 8)) {
+		std::cout << "error: runTests with jobs" << std::endl;
+		return	5;
+	}
+	const std::string	text = parallelOut.str();
+	for(size_t i = 1; i < 8; ++i) {
+		if(text.find("test " + std::to_string(i - 1)) > text.find("test " + std::to_string(i))) {
+			std::cout << "error: outputs of parallel tests are not in registration order: " << text << std::endl;
+			return	6;
+		}
+	}
+	// 失敗したテストは、再現に使うシードと共に表示される。
+	protest::TestRegistry	failingRegistry;
+	failingRegistry.add("failing", [](protest::TestContext &ctx) {
+			protest::TestResult	result;
+			result.abstract = "failing";
+			result.failedCase = ctx.seed();
+			ctx.report(result);
+		});
+	protest::RunnerOptions	seededOpts;
+	seededOpts.seed = 12345;
+	std::ostringstream	failingOut;
+	if((protest::runTests(failingRegistry, seededOpts, failingOut) != 1)
+			|| (failingOut.str().find("failing (--seed=12345)") == std::string::npos)) {
+		std::cout << "error: seed of the failed test is not printed: " << failingOut.str() << std::endl;
+		return	7;
+	}
+	// 環境変数のシャード指定も、コマンドラインと同じく不正な値をエラーにする。
+	char			suiteName[] = "suite";
+	char			*argv[] = {suiteName, nullptr};
+	std::ostringstream	parseErr;
+	protest::RunnerOptions	envOpts;
+	setenv("PROTEST_SHARD_INDEX", "1", 1);
+	setenv("PROTEST_SHARD_COUNT", "3", 1);
+	const bool		parsed = protest::parseRunnerOptions(1, argv, envOpts, parseErr);
+	setenv("PROTEST_SHARD_COUNT", "3x", 1);
+	const bool		malformed = protest::parseRunnerOptions(1, argv, envOpts, parseErr);
+	unsetenv("PROTEST_SHARD_INDEX");
+	unsetenv("PROTEST_SHARD_COUNT");
+	if(!parsed || (envOpts.shardIndex != 1) || (envOpts.shardCount != 3)) {
+		std::cout << "error: shard from the environment is not used: " << parseErr.str() << std::endl;
+		return	8;
+	}
+	if(malformed || (parseErr.str().find("invalid PROTEST_SHARD_COUNT: 3x") == std::string::npos)) {
+		std::cout << "error: malformed PROTEST_SHARD_COUNT is accepted" << std::endl;
+		return	9;
+	}
+	// 大きすぎる値は丸めずにエラーにする。
+	char			tooLarge[] = "--shard-count=99999999999999999999999";
+	char			*overflowArgv[] = {suiteName, tooLarge, nullptr};
+	protest::RunnerOptions	overflowOpts;
+	if(protest::parseRunnerOptions(2, overflowArgv, overflowOpts, parseErr)) {
+		std::cout << "error: overflowing --shard-count is accepted: " << overflowOpts.shardCount << std::endl;
+		return	10;
+	}
+	return	0;
+}
+
+int				fixtureTest(void)
+{
+	// 作るのが重いフィクスチャの代わり。 inUse で同時に使われていないことを確かめる。
+	struct	Index {
+		std::atomic<bool>	inUse;
+		std::vector<int32_t>	scratch;
+		Index()
+		:inUse(false)
+		,scratch()
+		{}
+	};
+	std::atomic<size_t>	resetCount(0);
+	protest::FixturePool<Index>	pool([] {
+				return	std::make_unique<Index>();
+			}, [&resetCount](Index &index) {
+				index.scratch.clear();
+				++resetCount;
+			});
+	protest::TestRegistry	registry;
+	for(size_t i = 0; i < 8; ++i) {
+		registry.add("fixture/" + std::to_string(i), [&pool](protest::TestContext &ctx) {
+				protest::SimpleTest<int32_t>	test("fixture is reset between cases",
+						protest::withFixture<int32_t>(pool, [](Index &index, const int32_t &x) {
+							protest::CheckResult	ret;
+							if(index.inUse.exchange(true)) {
+								ret.reason.emplace("fixture is shared between threads");
+							} else if(!index.scratch.empty()) {
+								ret.reason.emplace("fixture is not reset");
+							}
+							index.scratch.push_back(x);
+							std::this_thread::sleep_for(std::chrono::microseconds(20));
+							index.inUse = false;
+							return	ret;
+						}));
+				ctx.report(test.runTest("random case", protest::case_gen::Random<int32_t>(), 100));
+			});
+	}
+	protest::RunnerOptions	opts;
+	opts.jobs = 4;
+	std::ostringstream	oss;
+	if(protest::runTests(registry, opts, oss) != 0) {
+		std::cout << oss.str() << "error: fixture test failed" << std::endl;
+		return	1;
+	}
+	// ワーカーの数より多くは作られず、全て返却されている。
+	if((pool.created() == 0) || (pool.created() > 4) || (pool.available() != pool.created())) {
+		std::cout << "error: " << pool.created() << " fixtures are created" << std::endl;
+		return	2;
+	}
+	if(resetCount != 8 * 100) {
+		std::cout << "error: reset is called " << resetCount << " times" << std::endl;
+		return	3;
+	}
+	// タイムアウトで放棄されたケースがまだ使っているフィクスチャを、次のケースに渡さない。
+	{
+		std::atomic<size_t>	calls(0);
+		protest::SimpleTest<int32_t>	test("fixture is not shared with an abandoned case",
+				protest::withFixture<int32_t>(pool, [&calls](Index &index, const int32_t &) {
+					protest::CheckResult	ret;
+					if(index.inUse.exchange(true)) {
+						ret.reason.emplace("fixture is shared with an abandoned case");
+					}
+					if(calls++ == 0) {
+						std::this_thread::sleep_for(std::chrono::milliseconds(300));
+					}
+					index.inUse = false;
+					return	ret;
+				}));
+		test.timeout(std::chrono::milliseconds(20));
+		if(!test.runTest("first case times out", protest::case_gen::Random<int32_t>(), 10).isTestFailed()) {
+			std::cout << "error: the first case did not time out" << std::endl;
+			return	4;
+		}
+		test.clearError();
+		const auto		&result = test.runTest("next cases", protest::case_gen::Random<int32_t>(), 10);
+		if(result.isTestFailed()) {
+			protest::printResult(std::cout, result);
+			return	5;
+		}
+	}
+	// 放棄されたケースが終われば、そのフィクスチャもプールに返される。
+	for(int i = 0; (i < 200) && (pool.available() != pool.created()); ++i) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	if(pool.available() != pool.created()) {
+		std::cout << "error: the fixture of the abandoned case is not returned" << std::endl;
+		return	6;
+	}
+	return	0;
+}
+
+int				historyTest(void)
+{
+	const std::string	path = "protest_test_history.tmp";
+	std::remove(path.c_str());
+	protest::TestRegistry	registry;
+	std::string		runOrder;
+	const auto		add = [&registry, &runOrder](const char *name, bool fail, int sleepMs) {
+			registry.add(name, [name, fail, sleepMs, &runOrder](protest::TestContext &ctx) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs));
+					runOrder += name;
+					protest::TestResult	result;
+					result.abstract = name;
+					result.passCount = 10;
+					if(fail) {
+						result.failedCase = 0;
+						result.reason.emplace("failed");
+					}
+					ctx.report(result);
+				});
+		};
+	add("a", false, 20);
+	add("b", false, 1);
+	add("c", true, 1);
+	protest::RunnerOptions	opts;
+	opts.history = path;
+	std::ostringstream	oss;
+	// 記録がなければ登録順。
+	if((protest::runTests(registry, opts, oss) != 1) || (runOrder != "abc")) {
+		std::cout << "error: first run with history: " << runOrder << std::endl;
+		return	1;
+	}
+	protest::TestHistory	history;
+	const auto		*entry = history.load(path) ? history.find("a") : nullptr;
+	if(!entry || entry->lastFailed || (entry->runs != 1) || (entry->cases != 10) || (entry->duration < std::chrono::milliseconds(20))) {
+		std::cout << "error: history is not recorded" << std::endl;
+		return	2;
+	}
+	// 前回失敗したものが最初、次に速いもの。
+	runOrder.clear();
+	oss.str("");
+	if((protest::runTests(registry, opts, oss) != 1) || (runOrder != "cba")) {
+		std::cout << "error: second run with history: " << runOrder << std::endl;
+		return	3;
+	}
+	// 最初に実行した失敗は終わり次第書き、成功したものは実行順によらず登録順に書く。
+	const auto		out = oss.str();
+	const auto		posA = out.find("] a ");
+	const auto		posB = out.find("] b ");
+	const auto		posC = out.find("] c ");
+	if((posA == std::string::npos) || (posB == std::string::npos) || (posC == std::string::npos) || (posC > posA) || (posA > posB)) {
+		std::cout << "error: output is not in the expected order:\n" << out << std::endl;
+		return	5;
+	}
+	// 最初の失敗で止める。
+	runOrder.clear();
+	opts.failFast = true;
+	if((protest::runTests(registry, opts, oss) != 1) || (runOrder != "c")) {
+		std::cout << "error: fail-fast run: " << runOrder << std::endl;
+		return	4;
+	}
+	std::remove(path.c_str());
+	return	0;
+}
+
+int				soakTest(void)
+{
+	const std::string	corpus = "protest_test_soak_corpus.tmp";
+	const std::string	metricsPath = "protest_test_soak_metrics.tmp";
+	const auto		removeCorpus = [&corpus]() {
+			if(DIR *d = opendir(corpus.c_str())) {
+				while(dirent *ent = readdir(d)) {
+					if(ent->d_name[0] != '.') {
+						std::remove((corpus + '/' + ent->d_name).c_str());
+					}
+				}
+				closedir(d);
+				rmdir(corpus.c_str());
+			}
+		};
+	removeCorpus();
+	// 3回目の実行だけ失敗するテストと、半分のケースを skip するテスト。
+	std::mutex		mutex;
+	std::set<uint64_t>	seeds;
+	std::atomic<size_t>	failingRuns(0);
+	protest::TestRegistry	registry;
+	registry.add("soak/pass", [&mutex, &seeds](protest::TestContext &ctx) {
+			{
+				std::lock_guard<std::mutex>	lock(mutex);
+				seeds.insert(ctx.seed());
+			}
+			protest::SimpleTest<int32_t>	test("even numbers are even",
+					[](const int32_t &x) { return protest::AssertResult(x % 2 == 0, "odd"); },
+					[](const int32_t &x) { return x % 2 == 0; });
+			ctx.report(test.runTest("even case", protest::case_gen::Random<int32_t>(ctx.seed()), 100));
+		});
+	registry.add("soak/fail", [&failingRuns](protest::TestContext &ctx) {
+			protest::TestResult	result;
+			result.abstract = "fails at the third run";
+			result.passCount = 10;
+			if(++failingRuns == 3) {
+				result.failedCase = std::string("third");
+				result.reason.emplace("third run");
+			}
+			ctx.report(result);
+		});
+	protest::RunnerOptions	opts;
+	opts.soak = true;
+	opts.soakRounds = 5;
+	opts.jobs = 2;
+	opts.soakCorpus = corpus;
+	opts.metricsFile = metricsPath;
+	std::ostringstream	oss;
+	if(protest::runTests(registry, opts, oss) != 1) {
+		std::cout << oss.str() << "error: soak run does not report the failure" << std::endl;
+		return	1;
+	}
+	// 実行ごとにシードが変わる。
+	if((failingRuns != 5) || (seeds.size() != 5)) {
+		std::cout << "error: " << failingRuns << " runs, " << seeds.size() << " seeds" << std::endl;
+		return	2;
+	}
+	const auto		entries = protest::coverage::loadCorpus(corpus);
+	if((entries.size() != 1) || (entries[0].find("{\"test\":\"soak/fail\",\"round\":2,\"seed\":") != 0)
+			|| (entries[0].find("\"reason\":\"third run\"") == std::string::npos)) {
+		std::cout << "error: failure is not saved to the corpus" << std::endl;
+		return	3;
+	}
+	removeCorpus();
+	std::ifstream	ifs(metricsPath);
+	const std::string	metrics((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+	std::remove(metricsPath.c_str());
+	for(const char *line : {
+			"# TYPE protest_soak_runs_total counter\n",
+			"protest_soak_runs_total{test=\"soak/pass\"} 5\n",
+			"protest_soak_passes_total{test=\"soak/fail\"} 50\n",
+			"protest_soak_failures_total{test=\"soak/fail\"} 1\n",
+			"protest_soak_case_latency_seconds_count{test=\"soak/pass\"} 5\n",
+			}) {
+		if(metrics.find(line) == std::string::npos) {
+			std::cout << metrics << "error: metrics file lacks " << line << std::endl;
+			return	4;
+		}
+	}
+	// skip はおよそ半分。
+	const std::string	ratioKey = "protest_soak_skip_ratio{test=\"soak/pass\"} ";
+	const auto		ratioPos = metrics.find(ratioKey);
+	const double	ratio = (ratioPos == std::string::npos) ? 0.0 : std::atof(metrics.c_str() + ratioPos + ratioKey.size());
+	if(!(0.3 < ratio) || !(ratio < 0.7)) {
+		std::cout << "error: skip ratio " << ratio << std::endl;
+		return	5;
+	}
+	// 基準のシードを指定すれば、同じシードの列になる。
+	const auto		sameSeeds = [&](uint64_t seed) {
+			seeds.clear();
+			protest::RunnerOptions	seeded;
+			seeded.soak = true;
+			seeded.soakRounds = 3;
+			seeded.filters.push_back("soak/pass");
+			seeded.seed = seed;
+			protest::runTests(registry, seeded, protest::nullOstream());
+			return	seeds;
+		};
+	if(sameSeeds(42) != sameSeeds(42)) {
+		std::cout << "error: seeds are not reproducible" << std::endl;
+		return	6;
+	}
+	// 残ったソケットファイルは置き換えるが、他のプロセスが待ち受けているものは消さない。
+	const std::string	socketPath = "protest_test_soak_socket.tmp";
+	const auto		bindSocket = [&socketPath](bool listening) {
+			sockaddr_un		addr;
+			std::memset(&addr, 0, sizeof(addr));
+			addr.sun_family = AF_UNIX;
+			std::memcpy(addr.sun_path, socketPath.c_str(), socketPath.size() + 1);
+			const int		fd = socket(AF_UNIX, SOCK_STREAM, 0);
+			bind(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr));
+			if(listening) {
+				listen(fd, 1);
+			}
+			return	fd;
+		};
+	const auto		soakWithSocket = [&]() {
+			protest::RunnerOptions	served;
+			served.soak = true;
+			served.soakRounds = 1;
+			served.filters.push_back("soak/pass");
+			served.metricsSocket = socketPath;
+			std::ostringstream	out;
+			protest::runTests(registry, served, out);
+			return	out.str().find("cannot listen") == std::string::npos;
+		};
+	std::remove(socketPath.c_str());
+	close(bindSocket(false));
+	if(!soakWithSocket()) {
+		std::cout << "error: stale metrics socket is not replaced" << std::endl;
+		return	7;
+	}
+	const int		live = bindSocket(true);
+	struct stat		st;
+	const bool		refused = !soakWithSocket();
+	const bool		kept = (lstat(socketPath.c_str(), &st) == 0);
+	close(live);
+	std::remove(socketPath.c_str());
+	if(!refused || !kept) {
+		std::cout << "error: metrics socket of another process is removed" << std::endl;
+		return	8;
+	}
+	return	0;
+}
 
 template <uint64_t num>
 struct	Factorial : std::integral_constant<uint64_t, num*Factorial<num-1>{}> {};
@@ -350,6 +1828,72 @@ int				main(void)
 	if(( ret = protestGenericUtilTest() )) {
 		return	ret;
 	}
+	if(( ret = passAsNthTypeTest() )) {
+		return	ret;
+	}
+	if(( ret = genericBudgetTest() )) {
+		return	ret;
+	}
+	if(( ret = uniqueTest() )) {
+		return	ret;
+	}
+	if(( ret = checkpointTest() )) {
+		return	ret;
+	}
+	if(( ret = equivalentTest() )) {
+		return	ret;
+	}
+	if(( ret = isaVariantTest() )) {
+		return	ret;
+	}
+	if(( ret = bulkConditionTest() )) {
+		return	ret;
+	}
+	if(( ret = batchPropertyTest() )) {
+		return	ret;
+	}
+	if(( ret = snapshotTest() )) {
+		return	ret;
+	}
+	if(( ret = fuzzTest() )) {
+		return	ret;
+	}
+	if(( ret = sizedTest() )) {
+		return	ret;
+	}
+	if(( ret = asyncTest() )) {
+		return	ret;
+	}
+	if(( ret = timeoutTest() )) {
+		return	ret;
+	}
+	if(( ret = perfConditionTest() )) {
+		return	ret;
+	}
+	if(( ret = complexityTest() )) {
+		return	ret;
+	}
+	if(( ret = allocTest() )) {
+		return	ret;
+	}
+	if(( ret = perfCounterTest() )) {
+		return	ret;
+	}
+	if(( ret = reporterTest() )) {
+		return	ret;
+	}
+	if(( ret = runnerTest() )) {
+		return	ret;
+	}
+	if(( ret = fixtureTest() )) {
+		return	ret;
+	}
+	if(( ret = historyTest() )) {
+		return	ret;
+	}
+	if(( ret = soakTest() )) {
+		return	ret;
+	}
 	if(( ret = mplTest() )) {
 		return	0;
 	}
@@ -0,0 +1,301 @@
+/*!
+ * \file   reporter.cpp
+ * \brief  Machine-readable output of test results.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <ostream>
+#include <protest/reporter.hpp>
+
+namespace	nu11p0 {
+namespace	protest {
+
+namespace	detail {
+
+void			appendDecimal(std::string &buf, uint64_t val)
+{
+	// std::to_chars 相当。ロケールやストリームの状態に依存しない。
+	char			digits[20];
+	char			*p = digits + sizeof(digits);
+	do {
+		*--p = static_cast<char>('0' + (val % 10));
+		val /= 10;
+	} while(val);
+	buf.append(p, digits + sizeof(digits));
+}
+
+void			appendSeconds(std::string &buf, std::chrono::nanoseconds ns)
+{
+	auto			count = ns.count();
+	if(count < 0) {
+		buf.push_back('-');
+		count = -count;
+	}
+	const auto		total = static_cast<uint64_t>(count);
+	appendDecimal(buf, total / 1000000000u);
+	buf.push_back('.');
+	char			frac[9];
+	uint64_t		rem = total % 1000000000u;
+	for(size_t i = 9; i; --i) {
+		frac[i-1] = static_cast<char>('0' + (rem % 10));
+		rem /= 10;
+	}
+	buf.append(frac, sizeof(frac));
+}
+
+void			appendJsonString(std::string &buf, const std::string &str)
+{
+	static const char	hex[] = "0123456789abcdef";
+	buf.push_back('"');
+	for(unsigned char c : str) {
+		switch(c) {
+			case '"':
+				buf.append("\\\"", 2);
+				break;
+			case '\\':
+				buf.append("\\\\", 2);
+				break;
+			case '\n':
+				buf.append("\\n", 2);
+				break;
+			case '\r':
+				buf.append("\\r", 2);
+				break;
+			case '\t':
+				buf.append("\\t", 2);
+				break;
+			default:
+				if(c < 0x20) {
+					const char		esc[] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf]};
+					buf.append(esc, sizeof(esc));
+				} else {
+					buf.push_back(static_cast<char>(c));
+				}
+				break;
+		}
+	}
+	buf.push_back('"');
+}
+
+void			appendXmlEscaped(std::string &buf, const std::string &str)
+{
+	for(unsigned char c : str) {
+		switch(c) {
+			case '&':
+				buf.append("&amp;");
+				break;
+			case '<':
+				buf.append("&lt;");
+				break;
+			case '>':
+				buf.append("&gt;");
+				break;
+			case '"':
+				buf.append("&quot;");
+				break;
+			case '\n':
+				buf.append("&#10;");
+				break;
+			default:
+				// XML 1.0 で使えない制御文字は捨てる。
+				if((c >= 0x20) || (c == '\t') || (c == '\r')) {
+					buf.push_back(static_cast<char>(c));
+				}
+				break;
+		}
+	}
+}
+
+} // namespace detail
+
+/*
+ * Reporter
+ */
+Reporter::~Reporter() = default;
+
+void			Reporter::begin(void)
+{}
+
+void			Reporter::end(void)
+{}
+
+std::function<void(std::ostream &, const TestResult &)>	Reporter::printer(void)
+{
+	return	[this](std::ostream &, const TestResult &result) {
+			report(result);
+		};
+}
+
+/*
+ * TextReporter
+ */
+TextReporter::TextReporter(std::ostream &ost)
+:m_ost(ost)
+{}
+
+void			TextReporter::report(const TestResult &result)
+{
+	printResult(m_ost, result);
+}
+
+/*
+ * JsonLinesReporter
+ */
+JsonLinesReporter::JsonLinesReporter(std::ostream &ost)
+:m_ost(ost)
+,m_buffer()
+{}
+
+void			JsonLinesReporter::report(const TestResult &result)
+{
+	auto			&buf = m_buffer;
+	buf.clear();
+	buf.append("{\"abstract\":");
+	detail::appendJsonString(buf, result.abstract);
+	buf.append(",\"case\":");
+	detail::appendJsonString(buf, result.lastCaseDescription);
+	buf.append(result.failedCase.empty() ? ",\"status\":\"pass\"" : ",\"status\":\"fail\"");
+	buf.append(",\"pass\":");
+	detail::appendDecimal(buf, result.passCount);
+	buf.append(",\"skip\":");
+	detail::appendDecimal(buf, result.skipCount);
+	if(result.distinctCount) {
+		buf.append(",\"distinct\":");
+		detail::appendDecimal(buf, result.distinctCount);
+	}
+	buf.append(",\"elapsed_ns\":");
+	detail::appendDecimal(buf, static_cast<uint64_t>(result.elapsed.count()));
+	if(!result.failedCase.empty() && result.reason) {
+		buf.append(",\"reason\":");
+		detail::appendJsonString(buf, result.reason.value());
+	}
+	if(!result.complexity.bestFit.empty()) {
+		buf.append(",\"complexity\":");
+		detail::appendJsonString(buf, result.complexity.bestFit);
+		buf.append(",\"complexity_series\":[");
+		for(size_t i = 0; i < result.complexity.series.size(); ++i) {
+			const auto		&s = result.complexity.series[i];
+			buf.append(i ? ",[" : "[");
+			detail::appendDecimal(buf, s.size);
+			buf.push_back(',');
+			detail::appendDecimal(buf, static_cast<uint64_t>(s.elapsed.count()));
+			buf.push_back(']');
+		}
+		buf.push_back(']');
+	}
+	if(!result.counters.empty()) {
+		buf.append(",\"counters\":{");
+		bool			first = true;
+		for(size_t i = 0; i < PerfCounts::EventCount; ++i) {
+			const auto		e = static_cast<PerfCounts::Event>(i);
+			if(result.counters.has(e)) {
+				buf.append(first ? "\"" : ",\"");
+				buf.append(PerfCounts::name(e));
+				buf.append("\":");
+				detail::appendDecimal(buf, result.counters.get(e));
+				first = false;
+			}
+		}
+		buf.push_back('}');
+	}
+	if(!result.slowestCases.empty()) {
+		buf.append(",\"slowest_ns\":[");
+		for(size_t i = 0; i < result.slowestCases.size(); ++i) {
+			if(i) {
+				buf.push_back(',');
+			}
+			detail::appendDecimal(buf, static_cast<uint64_t>(result.slowestCases[i].elapsed.count()));
+		}
+		buf.push_back(']');
+	}
+	buf.append("}\n");
+	// 一件ごとにまとめて書き、フラッシュする。
+	m_ost.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+	m_ost.flush();
+}
+
+/*
+ * JUnitXmlReporter
+ */
+JUnitXmlReporter::JUnitXmlReporter(std::ostream &ost, std::string suiteName)
+:m_ost(ost)
+,m_buffer()
+,m_suiteName(std::move(suiteName))
+,m_tests()
+,m_failures()
+{}
+
+void			JUnitXmlReporter::begin(void)
+{
+	m_tests = 0;
+	m_failures = 0;
+	auto			&buf = m_buffer;
+	buf.assign("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuite name=\"");
+	detail::appendXmlEscaped(buf, m_suiteName);
+	buf.append("\">\n");
+	m_ost.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+	m_ost.flush();
+}
+
+void			JUnitXmlReporter::report(const TestResult &result)
+{
+	++m_tests;
+	if(!result.failedCase.empty()) {
+		++m_failures;
+	}
+	auto			&buf = m_buffer;
+	buf.assign("  <testcase name=\"");
+	detail::appendXmlEscaped(buf, result.abstract);
+	buf.append("\" classname=\"");
+	detail::appendXmlEscaped(buf, result.lastCaseDescription);
+	buf.append("\" time=\"");
+	detail::appendSeconds(buf, result.elapsed);
+	buf.append("\" assertions=\"");
+	detail::appendDecimal(buf, result.passCount);
+	buf.push_back('"');
+	if(result.failedCase.empty() && result.counters.empty()) {
+		buf.append("/>\n");
+	} else {
+		buf.append(">\n");
+		if(!result.counters.empty()) {
+			buf.append("    <properties>\n");
+			for(size_t i = 0; i < PerfCounts::EventCount; ++i) {
+				const auto		e = static_cast<PerfCounts::Event>(i);
+				if(result.counters.has(e)) {
+					buf.append("      <property name=\"");
+					buf.append(PerfCounts::name(e));
+					buf.append("\" value=\"");
+					detail::appendDecimal(buf, result.counters.get(e));
+					buf.append("\"/>\n");
+				}
+			}
+			buf.append("    </properties>\n");
+		}
+		if(!result.failedCase.empty()) {
+			buf.append("    <failure message=\"");
+			if(result.reason) {
+				detail::appendXmlEscaped(buf, result.reason.value());
+			}
+			buf.append("\"/>\n");
+		}
+		buf.append("  </testcase>\n");
+	}
+	m_ost.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+	m_ost.flush();
+}
+
+void			JUnitXmlReporter::end(void)
+{
+	auto			&buf = m_buffer;
+	buf.assign("  <properties>\n    <property name=\"tests\" value=\"");
+	detail::appendDecimal(buf, m_tests);
+	buf.append("\"/>\n    <property name=\"failures\" value=\"");
+	detail::appendDecimal(buf, m_failures);
+	buf.append("\"/>\n    <property name=\"errors\" value=\"0\"/>\n  </properties>\n</testsuite>\n");
+	m_ost.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+	m_ost.flush();
+}
+
+} // namespace protest
+} // namespace nu11p0
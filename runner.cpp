@@ -0,0 +1,728 @@
+/*!
+ * \file   runner.cpp
+ * \brief  Test registry and runner.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <protest/runner.hpp>
+#include <protest/reporter.hpp>
+#include <protest/history.hpp>
+#include <protest/soak.hpp>
+
+#include <protest/loligger_sgr_macro.h>
+
+namespace	nu11p0 {
+namespace	protest {
+
+/*
+ * TestContext
+ */
+TestContext::TestContext(std::ostream &ost, Reporter *reporter)
+:TestContext(ost, reporter, detail::randomSeed())
+{}
+
+TestContext::TestContext(std::ostream &ost, Reporter *reporter, uint64_t seed)
+:m_ost(ost)
+,m_reporter(reporter)
+,m_resultCount()
+,m_failureCount()
+,m_caseCount()
+,m_seed(seed)
+{}
+
+std::ostream	&TestContext::out(void)
+{
+	return	m_ost;
+}
+
+void			TestContext::report(const TestResult &result)
+{
+	++m_resultCount;
+	m_caseCount += result.passCount + result.skipCount;
+	if(!result.failedCase.empty()) {
+		++m_failureCount;
+	}
+	if(isOstreamAvailable(m_ost)) {
+		printResult(m_ost, result);
+	}
+	if(m_reporter) {
+		m_reporter->report(result);
+	}
+}
+
+void			TestContext::report(const SequentialTestResult &result)
+{
+	report(result.result);
+}
+
+std::function<void(std::ostream &, const TestResult &)>	TestContext::printer(void)
+{
+	return	[this](std::ostream &, const TestResult &result) {
+			report(result);
+		};
+}
+
+size_t			TestContext::resultCount(void) const
+{
+	return	m_resultCount;
+}
+
+size_t			TestContext::failureCount(void) const
+{
+	return	m_failureCount;
+}
+
+size_t			TestContext::caseCount(void) const
+{
+	return	m_caseCount;
+}
+
+bool			TestContext::failed(void) const
+{
+	return	m_failureCount != 0;
+}
+
+uint64_t		TestContext::seed(void) const
+{
+	return	m_seed;
+}
+
+/*
+ * TestRegistry
+ */
+TestRegistry::TestRegistry()
+:m_tests()
+{}
+
+TestRegistry	&TestRegistry::global(void)
+{
+	// 他の翻訳単位の静的初期化から使われるので、関数内staticにする。
+	static TestRegistry	registry;
+	return	registry;
+}
+
+void			TestRegistry::add(std::string name, TestFunction fun, std::chrono::nanoseconds expectedDuration)
+{
+	m_tests.push_back(TestInfo{std::move(name), std::move(fun), expectedDuration});
+}
+
+const std::vector<TestInfo>	&TestRegistry::tests(void) const
+{
+	return	m_tests;
+}
+
+Registration::Registration(std::string name, TestFunction fun, std::chrono::nanoseconds expectedDuration)
+{
+	TestRegistry::global().add(std::move(name), std::move(fun), expectedDuration);
+}
+
+/*
+ * Runner
+ */
+namespace	detail {
+
+uint64_t		randomSeed(void)
+{
+	std::random_device	rd;
+	return	(static_cast<uint64_t>(rd()) << 32) ^ rd();
+}
+
+void			runTestCatching(const TestInfo &test, TestContext &ctx)
+{
+	try {
+		test.fun(ctx);
+	} catch(const std::exception &e) {
+		TestResult		result;
+		result.abstract = test.name;
+		result.lastCaseDescription = "(uncaught exception)";
+		result.failedCase = std::string(e.what());
+		result.reason.emplace(std::string("uncaught exception: ") + e.what());
+		ctx.report(result);
+	} catch(...) {
+		TestResult		result;
+		result.abstract = test.name;
+		result.lastCaseDescription = "(uncaught exception)";
+		result.failedCase = std::string("unknown exception");
+		result.reason.emplace("uncaught exception of unknown type");
+		ctx.report(result);
+	}
+}
+
+} // namespace detail
+
+namespace	{
+
+const char		usage[] =
+	"Options:\n"
+	"  --filter=PATTERN       Run tests matching the glob pattern. '-PATTERN' excludes.\n"
+	"                         Can be given multiple times or separated by ','.\n"
+	"  --list                 List tests instead of running them.\n"
+	"  --shard-index=N        Run only the N-th shard (0-origin).\n"
+	"  --shard-count=M        Number of shards.\n"
+	"  --format=FORMAT        text (default), jsonl or junit.\n"
+	"  --output=FILE          Output file for jsonl and junit.\n"
+	"  --jobs=N               Run N tests in parallel (0: number of hardware threads).\n"
+	"  --history=FILE         Run previously failed and fast tests first, and record outcomes.\n"
+	"  --fail-fast            Stop at the first failed test.\n"
+	"  --seed=N               Seed passed to tests through TestContext::seed().\n"
+	"  --soak                 Run the tests repeatedly with rotating seeds until interrupted.\n"
+	"  --soak-rounds=N        Stop the soak run after N rounds.\n"
+	"  --soak-corpus=DIR      Save failed results of the soak run to the directory.\n"
+	"  --metrics-file=FILE    Write soak metrics in the Prometheus text format to the file.\n"
+	"  --metrics-socket=PATH  Serve soak metrics on the Unix domain socket.\n"
+	"  --metrics-interval=N   Rewrite the metrics file every N seconds (default: 10).\n"
+	"  --help                 Show this message.\n";
+
+void			stopSoakOnSignal(int)
+{
+	requestSoakStop();
+}
+
+bool			parseSize(const std::string &str, size_t &val)
+{
+	if(str.empty() || (str.find_first_not_of("0123456789") != std::string::npos)) {
+		return	false;
+	}
+	errno = 0;
+	const unsigned long long	n = std::strtoull(str.c_str(), nullptr, 10);
+	// 大きすぎる値は ULLONG_MAX に丸められるので、エラーにする。
+	if((errno == ERANGE) || (n > SIZE_MAX)) {
+		return	false;
+	}
+	val = static_cast<size_t>(n);
+	return	true;
+}
+
+bool			startsWith(const std::string &str, const char *prefix, std::string &rest)
+{
+	const std::string	p(prefix);
+	if(str.compare(0, p.size(), p) != 0) {
+		return	false;
+	}
+	rest = str.substr(p.size());
+	return	true;
+}
+
+void			splitFilters(const std::string &arg, std::vector<std::string> &filters)
+{
+	size_t			begin = 0;
+	while(begin <= arg.size()) {
+		size_t			end = arg.find(',', begin);
+		if(end == std::string::npos) {
+			end = arg.size();
+		}
+		if(end > begin) {
+			filters.push_back(arg.substr(begin, end - begin));
+		}
+		begin = end + 1;
+	}
+}
+
+//! Outcome of a test in this run.
+struct	TestOutcome {
+	bool			ran = false;
+	bool			failed = false;
+	std::chrono::nanoseconds	elapsed = std::chrono::nanoseconds::zero();
+	size_t			cases = 0;
+	//! TestContext::seed() 。失敗を --seed で再現できるよう表示する。
+	uint64_t		seed = 0;
+}; // struct TestOutcome
+
+//! Run a test and measure it.
+TestOutcome		runAndMeasure(const TestInfo &test, TestContext &ctx)
+{
+	TestOutcome		outcome;
+	const auto		startTime = std::chrono::steady_clock::now();
+	detail::runTestCatching(test, ctx);
+	outcome.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime);
+	outcome.ran = true;
+	outcome.failed = ctx.failed();
+	outcome.cases = ctx.caseCount();
+	outcome.seed = ctx.seed();
+	return	outcome;
+}
+
+//! Keep results to pass them to the real reporter later, in order.
+class	RecordingReporter : public Reporter {
+	public:
+		std::vector<TestResult>	results;
+		void			report(const TestResult &result) override
+		{
+			results.push_back(result);
+		}
+}; // class RecordingReporter
+
+//! Queues of test indices for each worker.
+/*!
+ * 各ワーカーは自分のキューの先頭から取り、空になったら他のワーカーのキューの先頭から盗む。
+ * キューは失敗しやすい順、同じなら見込み時間の長い順に並んでいるので、盗む場合も残りのうち長いものを取り、全体の終了時刻を早める。
+ */
+class	WorkStealingQueues {
+	private:
+		struct	Queue {
+			std::mutex		mutex;
+			std::deque<size_t>	tasks;
+		};
+		std::vector<std::unique_ptr<Queue>>	m_queues;
+	public:
+		//! Deal the tasks to the workers in the given order.
+		WorkStealingQueues(size_t workers, const std::vector<size_t> &order)
+		:m_queues()
+		{
+			for(size_t i = 0; i < workers; ++i) {
+				m_queues.emplace_back(new Queue());
+			}
+			for(size_t i = 0; i < order.size(); ++i) {
+				m_queues[i % workers]->tasks.push_back(order[i]);
+			}
+		}
+		bool			pop(size_t worker, size_t &task)
+		{
+			for(size_t i = 0; i < m_queues.size(); ++i) {
+				auto			&queue = *m_queues[(worker + i) % m_queues.size()];
+				std::lock_guard<std::mutex>	lock(queue.mutex);
+				if(!queue.tasks.empty()) {
+					task = queue.tasks.front();
+					queue.tasks.pop_front();
+					return	true;
+				}
+			}
+			return	false;
+		}
+}; // class WorkStealingQueues
+
+//! Run the tests in parallel, and write their outputs.
+/*!
+ * schedule はテストを始める順(selected の添字)。
+ * 失敗したテストの出力は終わり次第書き、成功したテストの出力は selected の順に書く。
+ * failFast なら、失敗したテストがあれば新たなテストを始めず、
+ * schedule でそれより後のテストの出力は、実行していても書かない。
+ */
+void			runTestsParallel(const std::vector<const TestInfo *> &selected, const std::vector<size_t> &schedule, size_t jobs, bool failFast, const ns_optional::optional<uint64_t> &seed, std::ostream &textOut, Reporter *reporter, std::vector<TestOutcome> &outcomes)
+{
+	struct	Slot {
+		std::ostringstream	out;
+		RecordingReporter	reporter;
+		bool			done = false;
+	};
+	const bool		textAvailable = isOstreamAvailable(textOut);
+	std::vector<Slot>	slots(selected.size());
+	// selected の添字から schedule での位置へ。
+	std::vector<size_t>	rank(selected.size());
+	for(size_t i = 0; i < schedule.size(); ++i) {
+		rank[schedule[i]] = i;
+	}
+	std::mutex		mutex;
+	std::condition_variable	cv;
+	std::atomic<bool>	stop(false);
+
+	const size_t	workers = std::min(jobs, selected.size());
+	WorkStealingQueues	queues(workers, schedule);
+	std::vector<std::thread>	threads;
+	for(size_t w = 0; w < workers; ++w) {
+		threads.emplace_back([&, w]() {
+				size_t			index;
+				while(queues.pop(w, index)) {
+					auto			&slot = slots[index];
+					TestOutcome		outcome;
+					if(!stop) {
+						TestContext		ctx(textAvailable ? static_cast<std::ostream &>(slot.out) : nullOstream(), &slot.reporter,
+								seed ? *seed : detail::randomSeed());
+						outcome = runAndMeasure(*selected[index], ctx);
+						if(failFast && outcome.failed) {
+							stop = true;
+						}
+					}
+					// 止めた後に取り出したテストも、実行せずに終わったことにして書き出し側を進める。
+					std::lock_guard<std::mutex>	lock(mutex);
+					outcomes[index] = outcome;
+					slot.done = true;
+					cv.notify_all();
+				}
+			});
+	}
+	// 失敗したテストは終わり次第、成功したテストは登録順に書き出す。
+	const auto		write = [&](size_t i) {
+			if(textAvailable) {
+				textOut << slots[i].out.str() << std::flush;
+			}
+			if(reporter) {
+				for(const auto &result : slots[i].reporter.results) {
+					reporter->report(result);
+				}
+			}
+		};
+	std::vector<bool>	written(slots.size());
+	size_t			next = 0;
+	while(next < slots.size()) {
+		std::vector<size_t>	failures;
+		std::vector<size_t>	passes;
+		{
+			std::unique_lock<std::mutex>	lock(mutex);
+			// schedule で先に始めたテストが全て終わるまで、 failFast で捨てるかどうか分からない。
+			const auto		settled = [&](size_t i) {
+					if(!slots[i].done) {
+						return	false;
+					}
+					for(size_t k = 0; failFast && (k < rank[i]); ++k) {
+						if(!slots[schedule[k]].done) {
+							return	false;
+						}
+					}
+					return	true;
+				};
+			const auto		discarded = [&](size_t i) {
+					for(size_t k = 0; failFast && (k < rank[i]); ++k) {
+						if(outcomes[schedule[k]].failed) {
+							return	true;
+						}
+					}
+					return	false;
+				};
+			cv.wait(lock, [&]() {
+					for(size_t i = next; i < slots.size(); ++i) {
+						if(!written[i] && settled(i) && ((i == next) || outcomes[i].failed)) {
+							return	true;
+						}
+					}
+					return	false;
+				});
+			for(size_t i = next; i < slots.size(); ++i) {
+				if(written[i] || !settled(i)) {
+					continue;
+				}
+				if(discarded(i)) {
+					// 失敗したテストより後に始めたものは、実行していても捨てる。
+					outcomes[i] = TestOutcome();
+					written[i] = true;
+				} else if(outcomes[i].failed) {
+					failures.push_back(i);
+					written[i] = true;
+				}
+			}
+			for(; (next < slots.size()) && (written[next] || settled(next)); ++next) {
+				if(!written[next]) {
+					written[next] = true;
+					if(outcomes[next].ran) {
+						passes.push_back(next);
+					}
+				}
+			}
+		}
+		for(const auto i : failures) {
+			write(i);
+		}
+		for(const auto i : passes) {
+			write(i);
+		}
+	}
+	for(auto &t : threads) {
+		t.join();
+	}
+}
+
+} // anonymous namespace
+
+bool			parseRunnerOptions(int argc, char **argv, RunnerOptions &opts, std::ostream &err)
+{
+	// 空の環境変数は設定されていないものとして扱う。
+	const char		*env = std::getenv("PROTEST_SHARD_INDEX");
+	if(env && *env && !parseSize(env, opts.shardIndex)) {
+		err << "invalid PROTEST_SHARD_INDEX: " << env << '\n';
+		return	false;
+	}
+	env = std::getenv("PROTEST_SHARD_COUNT");
+	if(env && *env && !parseSize(env, opts.shardCount)) {
+		err << "invalid PROTEST_SHARD_COUNT: " << env << '\n';
+		return	false;
+	}
+	for(int i = 1; i < argc; ++i) {
+		const std::string	arg(argv[i]);
+		std::string		val;
+		if(startsWith(arg, "--filter=", val)) {
+			splitFilters(val, opts.filters);
+		} else if(arg == "--list") {
+			opts.listOnly = true;
+		} else if(startsWith(arg, "--shard-index=", val)) {
+			if(!parseSize(val, opts.shardIndex)) {
+				err << "invalid shard index: " << val << '\n';
+				return	false;
+			}
+		} else if(startsWith(arg, "--shard-count=", val)) {
+			if(!parseSize(val, opts.shardCount)) {
+				err << "invalid shard count: " << val << '\n';
+				return	false;
+			}
+		} else if(startsWith(arg, "--format=", val)) {
+			if((val != "text") && (val != "jsonl") && (val != "junit")) {
+				err << "unknown format: " << val << '\n';
+				return	false;
+			}
+			opts.format = val;
+		} else if(startsWith(arg, "--output=", val)) {
+			opts.output = val;
+		} else if(startsWith(arg, "--history=", val)) {
+			opts.history = val;
+		} else if(arg == "--fail-fast") {
+			opts.failFast = true;
+		} else if(startsWith(arg, "--jobs=", val)) {
+			if(!parseSize(val, opts.jobs)) {
+				err << "invalid number of jobs: " << val << '\n';
+				return	false;
+			}
+		} else if(startsWith(arg, "--seed=", val)) {
+			size_t			seed;
+			if(!parseSize(val, seed)) {
+				err << "invalid seed: " << val << '\n';
+				return	false;
+			}
+			opts.seed = static_cast<uint64_t>(seed);
+		} else if(arg == "--soak") {
+			opts.soak = true;
+		} else if(startsWith(arg, "--soak-rounds=", val)) {
+			if(!parseSize(val, opts.soakRounds)) {
+				err << "invalid number of rounds: " << val << '\n';
+				return	false;
+			}
+		} else if(startsWith(arg, "--soak-corpus=", val)) {
+			opts.soakCorpus = val;
+		} else if(startsWith(arg, "--metrics-file=", val)) {
+			opts.metricsFile = val;
+		} else if(startsWith(arg, "--metrics-socket=", val)) {
+			opts.metricsSocket = val;
+		} else if(startsWith(arg, "--metrics-interval=", val)) {
+			size_t			seconds;
+			if(!parseSize(val, seconds) || !seconds) {
+				err << "invalid metrics interval: " << val << '\n';
+				return	false;
+			}
+			opts.metricsInterval = std::chrono::seconds(seconds);
+		} else if(arg == "--help") {
+			opts.showHelp = true;
+			err << "Usage: " << argv[0] << " [options]\n" << usage;
+			return	false;
+		} else {
+			err << "unknown option: " << arg << '\n' << usage;
+			return	false;
+		}
+	}
+	if(!opts.shardCount || (opts.shardIndex >= opts.shardCount)) {
+		err << "shard index must be less than shard count\n";
+		return	false;
+	}
+	return	true;
+}
+
+bool			globMatch(const std::string &pattern, const std::string &name)
+{
+	// '*' に出会った位置を覚えておき、失敗したらそこからやり直す。
+	size_t			p = 0, n = 0;
+	size_t			starP = std::string::npos, starN = 0;
+	while(n < name.size()) {
+		if((p < pattern.size()) && ((pattern[p] == '?') || (pattern[p] == name[n]))) {
+			++p;
+			++n;
+		} else if((p < pattern.size()) && (pattern[p] == '*')) {
+			starP = p++;
+			starN = n;
+		} else if(starP != std::string::npos) {
+			p = starP + 1;
+			n = ++starN;
+		} else {
+			return	false;
+		}
+	}
+	while((p < pattern.size()) && (pattern[p] == '*')) {
+		++p;
+	}
+	return	p == pattern.size();
+}
+
+std::vector<const TestInfo *>	selectTests(const TestRegistry &registry, const RunnerOptions &opts)
+{
+	bool			hasPositive = false;
+	for(const auto &f : opts.filters) {
+		if(f.empty() || (f[0] != '-')) {
+			hasPositive = true;
+		}
+	}
+	std::vector<const TestInfo *>	selected;
+	size_t			index = 0;
+	for(const auto &test : registry.tests()) {
+		bool			included = !hasPositive;
+		bool			excluded = false;
+		for(const auto &f : opts.filters) {
+			if(!f.empty() && (f[0] == '-')) {
+				excluded = excluded || globMatch(f.substr(1), test.name);
+			} else {
+				included = included || globMatch(f, test.name);
+			}
+		}
+		if(!included || excluded) {
+			continue;
+		}
+		if((index++ % opts.shardCount) == opts.shardIndex) {
+			selected.push_back(&test);
+		}
+	}
+	return	selected;
+}
+
+int				runTests(const TestRegistry &registry, const RunnerOptions &opts, std::ostream &ost)
+{
+	if(opts.soak && !opts.listOnly) {
+		return	runSoak(registry, opts, ost);
+	}
+	const auto		selected = selectTests(registry, opts);
+	TestHistory		history;
+	bool			brokenHistory = false;
+	if(!opts.history.empty()) {
+		brokenHistory = !history.load(opts.history);
+		if(brokenHistory) {
+			history = TestHistory();
+		}
+	}
+	if(opts.listOnly) {
+		for(const auto *test : selected) {
+			ost << test->name << '\n';
+		}
+		ost.flush();
+		return	0;
+	}
+
+	std::ofstream	ofs;
+	std::ostream	*structuredOut = &ost;
+	if(!opts.output.empty()) {
+		ofs.open(opts.output, std::ios::out | std::ios::trunc);
+		if(!ofs) {
+			ost << "cannot open output file: " << opts.output << std::endl;
+			return	1;
+		}
+		structuredOut = &ofs;
+	}
+	std::unique_ptr<Reporter>	reporter;
+	if(opts.format == "jsonl") {
+		reporter.reset(new JsonLinesReporter(*structuredOut));
+	} else if(opts.format == "junit") {
+		reporter.reset(new JUnitXmlReporter(*structuredOut));
+	}
+	// 構造化された出力を標準出力に書く場合は、テキストの出力を混ぜない。
+	std::ostream	&textOut = (reporter && (structuredOut == &ost)) ? nullOstream() : ost;
+	const bool		textAvailable = isOstreamAvailable(textOut);
+
+	if(brokenHistory && textAvailable) {
+		textOut << "ignoring broken history file: " << opts.history << std::endl;
+	}
+	if(reporter) {
+		reporter->begin();
+	}
+	std::vector<TestOutcome>	outcomes(selected.size());
+	const size_t	jobs = opts.jobs ? opts.jobs : std::max<size_t>(1, std::thread::hardware_concurrency());
+	// 履歴があれば、失敗しやすいものと短いものから始める。出力は登録順のまま。
+	auto			schedule = history.schedule(selected);
+	if(jobs > 1) {
+		// 失敗しやすいものを先に。同じ失敗のしやすさなら、全体が早く終わるよう長いものから始める。
+		std::vector<std::chrono::nanoseconds>	expected(selected.size());
+		std::vector<double>	failureScore(selected.size());
+		for(size_t i = 0; i < selected.size(); ++i) {
+			const auto		*entry = history.find(selected[i]->name);
+			expected[i] = (entry && entry->runs) ? entry->duration : selected[i]->expectedDuration;
+			failureScore[i] = entry ? entry->failureScore : 0.0;
+		}
+		std::stable_sort(schedule.begin(), schedule.end(), [&expected, &failureScore](size_t a, size_t b) {
+				if(failureScore[a] > failureScore[b]) {
+					return	true;
+				}
+				if(failureScore[a] < failureScore[b]) {
+					return	false;
+				}
+				return	expected[a] > expected[b];
+			});
+		runTestsParallel(selected, schedule, jobs, opts.failFast, opts.seed, textOut, reporter.get(), outcomes);
+	} else if(!opts.history.empty()) {
+		// 登録順と違う順に実行するので、並列の場合と同じく出力をバッファして並べ直す。
+		runTestsParallel(selected, schedule, 1, opts.failFast, opts.seed, textOut, reporter.get(), outcomes);
+	} else {
+		for(size_t i = 0; i < selected.size(); ++i) {
+			TestContext		ctx(textOut, reporter.get(), opts.seed ? *opts.seed : detail::randomSeed());
+			outcomes[i] = runAndMeasure(*selected[i], ctx);
+			if(opts.failFast && outcomes[i].failed) {
+				break;
+			}
+		}
+	}
+	std::vector<std::string>	failedNames;
+	std::vector<uint64_t>	failedSeeds;
+	size_t			notRun = 0;
+	for(size_t i = 0; i < selected.size(); ++i) {
+		const auto		&outcome = outcomes[i];
+		if(!outcome.ran) {
+			++notRun;
+			continue;
+		}
+		if(outcome.failed) {
+			failedNames.push_back(selected[i]->name);
+			failedSeeds.push_back(outcome.seed);
+		}
+		if(!opts.history.empty()) {
+			history.update(selected[i]->name, outcome.failed, outcome.elapsed, outcome.cases);
+		}
+	}
+	if(!opts.history.empty() && !history.save(opts.history) && textAvailable) {
+		textOut << "cannot write history file: " << opts.history << std::endl;
+	}
+	if(reporter) {
+		reporter->end();
+	}
+
+	if(textAvailable) {
+		textOut << "\n" << selected.size() << " tests";
+		if(opts.shardCount > 1) {
+			textOut << " (shard " << opts.shardIndex << '/' << opts.shardCount << ')';
+		}
+		textOut << ", " << failedNames.size() << " failed";
+		if(notRun) {
+			textOut << ", " << notRun << " not run (--fail-fast)";
+		}
+		textOut << '\n';
+		for(size_t i = 0; i < failedNames.size(); ++i) {
+			textOut << "[" SGR(BOLD, FG_RED) "FAIL" SGR(RESET) "] " << failedNames[i] << " (--seed=" << failedSeeds[i] << ")\n";
+		}
+		textOut.flush();
+	}
+	return	failedNames.empty() ? 0 : 1;
+}
+
+int				runMain(int argc, char **argv)
+{
+	RunnerOptions	opts;
+	if(!parseRunnerOptions(argc, argv, opts, std::cerr)) {
+		return	opts.showHelp ? 0 : 2;
+	}
+	if(opts.soak) {
+		std::signal(SIGINT, stopSoakOnSignal);
+		std::signal(SIGTERM, stopSoakOnSignal);
+	}
+	return	runTests(TestRegistry::global(), opts, std::cout);
+}
+
+} // namespace protest
+} // namespace nu11p0
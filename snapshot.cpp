@@ -0,0 +1,349 @@
+/*!
+ * \file   snapshot.cpp
+ * \brief  Conditions comparing large outputs with golden files.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <protest/snapshot.hpp>
+
+namespace	nu11p0 {
+namespace	protest {
+
+namespace	{
+
+const char		indexHeader[] = "protest-snapshot-index 1";
+
+// xxHash64 と同じ定数と混合。
+constexpr uint64_t	prime1 = 0x9e3779b185ebca87ULL;
+constexpr uint64_t	prime2 = 0xc2b2ae3d27d4eb4fULL;
+constexpr uint64_t	prime3 = 0x165667b19e3779f9ULL;
+
+inline uint64_t	rotl(uint64_t x, int r)
+{
+	return	(x << r) | (x >> (64 - r));
+}
+
+inline uint64_t	load64(const uint8_t *p)
+{
+	uint64_t		ret;
+	std::memcpy(&ret, p, sizeof(ret));
+	return	ret;
+}
+
+inline uint64_t	mixRound(uint64_t acc, uint64_t input)
+{
+	return	rotl(acc + input * prime2, 31) * prime1;
+}
+
+//! Read-only mapping of a whole file.
+class	MappedFile {
+	private:
+		int				m_fd;
+		const uint8_t	*m_data;
+		size_t			m_size;
+		long long		m_mtime;
+	public:
+		MappedFile()
+		:m_fd(-1)
+		,m_data(nullptr)
+		,m_size()
+		,m_mtime()
+		{}
+		MappedFile(const MappedFile &) = delete;
+		MappedFile		&operator=(const MappedFile &) = delete;
+		~MappedFile()
+		{
+			if(m_data) {
+				::munmap(const_cast<uint8_t *>(m_data), m_size);
+			}
+			if(m_fd >= 0) {
+				::close(m_fd);
+			}
+		}
+		bool			open(const std::string &path)
+		{
+			m_fd = ::open(path.c_str(), O_RDONLY);
+			struct stat		st;
+			if((m_fd < 0) || (::fstat(m_fd, &st) != 0)) {
+				return	false;
+			}
+			m_size = static_cast<size_t>(st.st_size);
+#ifdef	__linux__
+			m_mtime = static_cast<long long>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+#else
+			m_mtime = static_cast<long long>(st.st_mtime) * 1000000000LL;
+#endif
+			// 大きさ0のファイルは mmap できない。
+			if(m_size == 0) {
+				return	true;
+			}
+			void			*p = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+			if(p == MAP_FAILED) {
+				return	false;
+			}
+			m_data = static_cast<const uint8_t *>(p);
+			return	true;
+		}
+		//! Hint that the whole file is about to be read.
+		void			willReadAll(void) const
+		{
+			if(m_data) {
+				::madvise(const_cast<uint8_t *>(m_data), m_size, MADV_SEQUENTIAL);
+			}
+		}
+		const uint8_t	*data(void) const
+		{
+			return	m_data;
+		}
+		size_t			size(void) const
+		{
+			return	m_size;
+		}
+		long long		mtime(void) const
+		{
+			return	m_mtime;
+		}
+}; // class MappedFile
+
+struct	SnapshotIndex {
+	size_t			size;
+	long long		mtime;
+	size_t			chunkSize;
+	std::vector<uint64_t>	hashes;
+}; // struct SnapshotIndex
+
+bool			readIndex(const std::string &path, SnapshotIndex &index)
+{
+	std::ifstream	ifs(path);
+	std::string		header;
+	size_t			count;
+	if(!ifs || !std::getline(ifs, header) || (header != indexHeader)
+			|| !(ifs >> index.size >> index.mtime >> index.chunkSize >> count)) {
+		return	false;
+	}
+	index.hashes.resize(count);
+	for(auto &h : index.hashes) {
+		if(!(ifs >> std::hex >> h)) {
+			return	false;
+		}
+	}
+	return	true;
+}
+
+// 索引は壊れても作り直せるが、途中まで書かれたものを読まないよう一時ファイルを経由する。
+bool			writeIndex(const std::string &path, const SnapshotIndex &index)
+{
+	const std::string	tmp = path + ".tmp";
+	{
+		std::ofstream	ofs(tmp, std::ios::out | std::ios::trunc);
+		if(!ofs) {
+			return	false;
+		}
+		ofs << indexHeader << '\n'
+			<< index.size << ' ' << index.mtime << ' ' << index.chunkSize << ' ' << index.hashes.size() << '\n'
+			<< std::hex;
+		for(const auto h : index.hashes) {
+			ofs << h << '\n';
+		}
+		if(!ofs.flush()) {
+			return	false;
+		}
+	}
+	return	std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+bool			writeGolden(const std::string &path, const void *data, size_t size)
+{
+	const std::string	tmp = path + ".tmp";
+	{
+		std::ofstream	ofs(tmp, std::ios::out | std::ios::trunc | std::ios::binary);
+		if(!ofs || !ofs.write(static_cast<const char *>(data), static_cast<std::streamsize>(size)) || !ofs.flush()) {
+			return	false;
+		}
+	}
+	return	std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+std::string		hexBytes(const uint8_t *p, size_t n)
+{
+	static const char	digits[] = "0123456789abcdef";
+	std::string		ret;
+	for(size_t i = 0; i < n; ++i) {
+		if(i) {
+			ret += ' ';
+		}
+		ret += digits[p[i] >> 4];
+		ret += digits[p[i] & 0xf];
+	}
+	return	ret;
+}
+
+CheckResult		updateSnapshot(const std::string &goldenPath, const void *data, size_t size, const SnapshotOptions &options)
+{
+	CheckResult		ret;
+	if(!writeGolden(goldenPath, data, size)) {
+		ret.reason.emplace("cannot write golden file " + goldenPath);
+		return	ret;
+	}
+	// 更新時刻は書いた後のファイルから取る。
+	MappedFile		golden;
+	if(golden.open(goldenPath)) {
+		SnapshotIndex	index{size, golden.mtime(), options.chunkSize, detail::chunkHashes(data, size, options.chunkSize)};
+		writeIndex(detail::snapshotIndexPath(goldenPath), index);
+	}
+	return	ret;
+}
+
+} // anonymous namespace
+
+SnapshotMode	defaultSnapshotMode(void)
+{
+	const char		*env = std::getenv("PROTEST_UPDATE_SNAPSHOTS");
+	return	(env && *env && std::strcmp(env, "0")) ? SnapshotMode::Update : SnapshotMode::Compare;
+}
+
+namespace	detail {
+
+uint64_t		chunkHash(const void *data, size_t size)
+{
+	const uint8_t	*p = static_cast<const uint8_t *>(data);
+	const uint8_t	*const end = p + size;
+	uint64_t		h;
+	if(size >= 32) {
+		// 4本の独立な累積値で、乗算の待ち時間を隠す。
+		uint64_t		v1 = prime1 + prime2;
+		uint64_t		v2 = prime2;
+		uint64_t		v3 = 0;
+		uint64_t		v4 = 0 - prime1;
+		for(; p + 32 <= end; p += 32) {
+			v1 = mixRound(v1, load64(p));
+			v2 = mixRound(v2, load64(p + 8));
+			v3 = mixRound(v3, load64(p + 16));
+			v4 = mixRound(v4, load64(p + 24));
+		}
+		h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+		for(const uint64_t v : {v1, v2, v3, v4}) {
+			h = (h ^ mixRound(0, v)) * prime1 + prime3;
+		}
+	} else {
+		h = prime3;
+	}
+	h += size;
+	for(; p + 8 <= end; p += 8) {
+		h = rotl(h ^ mixRound(0, load64(p)), 27) * prime1 + prime3;
+	}
+	for(; p < end; ++p) {
+		h = rotl(h ^ (*p * prime3), 11) * prime1;
+	}
+	h ^= h >> 33;
+	h *= prime2;
+	h ^= h >> 29;
+	h *= prime3;
+	h ^= h >> 32;
+	return	h;
+}
+
+std::vector<uint64_t>	chunkHashes(const void *data, size_t size, size_t chunkSize)
+{
+	const uint8_t	*p = static_cast<const uint8_t *>(data);
+	std::vector<uint64_t>	ret;
+	if(!chunkSize) {
+		return	ret;
+	}
+	ret.reserve((size + chunkSize - 1) / chunkSize);
+	for(size_t offset = 0; offset < size; offset += chunkSize) {
+		ret.push_back(chunkHash(p + offset, std::min(chunkSize, size - offset)));
+	}
+	return	ret;
+}
+
+std::string		snapshotIndexPath(const std::string &goldenPath)
+{
+	return	goldenPath + ".idx";
+}
+
+} // namespace detail
+
+CheckResult		checkSnapshot(const std::string &goldenPath, const void *data, size_t size, const SnapshotOptions &options)
+{
+	if(!options.chunkSize) {
+		CheckResult		ret;
+		ret.reason.emplace("invalid snapshot chunk size: 0");
+		return	ret;
+	}
+	if(options.mode == SnapshotMode::Update) {
+		return	updateSnapshot(goldenPath, data, size, options);
+	}
+	CheckResult		ret;
+	MappedFile		golden;
+	if(!golden.open(goldenPath)) {
+		ret.reason.emplace("cannot open golden file " + goldenPath + " (set PROTEST_UPDATE_SNAPSHOTS=1 to create it)");
+		return	ret;
+	}
+	const std::string	indexPath = detail::snapshotIndexPath(goldenPath);
+	SnapshotIndex	index;
+	if(!readIndex(indexPath, index) || (index.size != golden.size()) || (index.mtime != golden.mtime())
+			|| (index.chunkSize != options.chunkSize)
+			|| (index.hashes.size() != (golden.size() + options.chunkSize - 1) / options.chunkSize)) {
+		golden.willReadAll();
+		index = SnapshotIndex{golden.size(), golden.mtime(), options.chunkSize,
+				detail::chunkHashes(golden.data(), golden.size(), options.chunkSize)};
+		// 書けなくても比較はできる。
+		writeIndex(indexPath, index);
+	}
+
+	const uint8_t	*actual = static_cast<const uint8_t *>(data);
+	const size_t	common = std::min(size, golden.size());
+	std::string		regions;
+	size_t			regionCount = 0;
+	for(size_t k = 0, offset = 0; offset < common; ++k, offset += options.chunkSize) {
+		const size_t	length = std::min(options.chunkSize, size - offset);
+		if((k < index.hashes.size()) && (length == std::min(options.chunkSize, golden.size() - offset))
+				&& (detail::chunkHash(actual + offset, length) == index.hashes[k])) {
+			continue;
+		}
+		// 食い違ったチャンクだけゴールデンファイルを読む。
+		const size_t	end = std::min(offset + options.chunkSize, common);
+		size_t			first = offset;
+		while((first < end) && (actual[first] == golden.data()[first])) {
+			++first;
+		}
+		if(first == end) {
+			// 末尾のチャンクで、共通部分は一致し大きさだけが違う。
+			continue;
+		}
+		size_t			last = end - 1;
+		while(actual[last] == golden.data()[last]) {
+			--last;
+		}
+		if(regionCount++ < options.maxRegions) {
+			const size_t	n = std::min(options.contextBytes, common - first);
+			regions += "; bytes " + std::to_string(first) + ".." + std::to_string(last) + " (chunk " + std::to_string(k) + ")"
+					+ ": golden=" + hexBytes(golden.data() + first, n) + ", actual=" + hexBytes(actual + first, n);
+		}
+	}
+	if(options.maxRegions < regionCount) {
+		regions += "; and " + std::to_string(regionCount - options.maxRegions) + " more differing chunks";
+	}
+	if((size != golden.size()) || regionCount) {
+		std::string		reason = "output differs from golden file " + goldenPath;
+		if(size != golden.size()) {
+			reason += ": size differs: golden=" + std::to_string(golden.size()) + ", actual=" + std::to_string(size);
+		}
+		ret.reason.emplace(reason + regions);
+	}
+	return	ret;
+}
+
+} // namespace protest
+} // namespace nu11p0
@@ -0,0 +1,426 @@
+/*!
+ * \file   soak.cpp
+ * \brief  Soak mode: running registered tests continuously with live metrics.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <thread>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <protest/soak.hpp>
+#include <protest/reporter.hpp>
+#include <protest/fuzz.hpp>
+
+#include <protest/loligger_sgr_macro.h>
+
+namespace	nu11p0 {
+namespace	protest {
+
+namespace	{
+
+// シグナルハンドラから書き込むので、ロックフリーなアトミック変数にする。
+std::atomic<bool>	soakStop(false);
+
+double			toSeconds(std::chrono::nanoseconds ns)
+{
+	return	std::chrono::duration<double>(ns).count();
+}
+
+//! Results reported during a run of a test.
+class	CollectingReporter : public Reporter {
+	public:
+		std::vector<TestResult>	results;
+		void			report(const TestResult &result) override
+		{
+			results.push_back(result);
+		}
+}; // class CollectingReporter
+
+//! Serve the metrics to each connection to the Unix domain socket.
+class	MetricsSocket {
+	private:
+		int				m_fd;
+		std::string		m_path;
+	public:
+		MetricsSocket()
+		:m_fd(-1)
+		,m_path()
+		{}
+		MetricsSocket(const MetricsSocket &) = delete;
+		MetricsSocket	&operator=(const MetricsSocket &) = delete;
+		~MetricsSocket()
+		{
+			if(m_fd >= 0) {
+				::close(m_fd);
+			}
+			if(!m_path.empty()) {
+				::unlink(m_path.c_str());
+			}
+		}
+		bool			listen(const std::string &path)
+		{
+			sockaddr_un		addr;
+			std::memset(&addr, 0, sizeof(addr));
+			addr.sun_family = AF_UNIX;
+			if(path.size() >= sizeof(addr.sun_path)) {
+				return	false;
+			}
+			std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+			m_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+			if(m_fd < 0) {
+				return	false;
+			}
+			const auto		bind = [this, &addr]() {
+					return	::bind(m_fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) == 0;
+				};
+			// 前回の実行が残したソケットファイルだけを消す。接続できるなら他のプロセスが使っている。
+			if(!bind() && ((errno != EADDRINUSE) || !isStaleSocket(addr) || (::unlink(path.c_str()) != 0) || !bind())) {
+				return	false;
+			}
+			// 自分で作ったファイルだけを、破棄するときに消す。
+			m_path = path;
+			return	::listen(m_fd, 8) == 0;
+		}
+		//! Check whether the file is a socket on which no process accepts connections.
+		static bool		isStaleSocket(const sockaddr_un &addr)
+		{
+			struct stat		st;
+			if((::lstat(addr.sun_path, &st) != 0) || !S_ISSOCK(st.st_mode)) {
+				return	false;
+			}
+			const int		fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+			if(fd < 0) {
+				// 確かめられなければ、使われているものとして消さない。
+				return	false;
+			}
+			const bool		ret = (::connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0) && (errno == ECONNREFUSED);
+			::close(fd);
+			return	ret;
+		}
+		//! Accept connections until done becomes true.
+		void			serve(const SoakMetrics &metrics, const std::atomic<bool> &done)
+		{
+			while(!done) {
+				pollfd			p{m_fd, POLLIN, 0};
+				if(::poll(&p, 1, 100) <= 0) {
+					continue;
+				}
+				const int		conn = ::accept(m_fd, nullptr, nullptr);
+				if(conn < 0) {
+					continue;
+				}
+				const std::string	text = metrics.prometheusText();
+				for(size_t sent = 0; sent < text.size(); ) {
+					// 読み手が先に切断しても SIGPIPE で落ちないようにする。
+					const ssize_t	n = ::send(conn, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+					if(n <= 0) {
+						break;
+					}
+					sent += static_cast<size_t>(n);
+				}
+				::close(conn);
+			}
+		}
+}; // class MetricsSocket
+
+//! One JSON line describing the run, followed by the failed results.
+std::string		failureRecord(const std::string &test, size_t round, uint64_t seed, const std::vector<TestResult> &results)
+{
+	std::string		buf("{\"test\":");
+	detail::appendJsonString(buf, test);
+	buf.append(",\"round\":");
+	detail::appendDecimal(buf, round);
+	buf.append(",\"seed\":");
+	detail::appendDecimal(buf, seed);
+	buf.append("}\n");
+	std::ostringstream	oss;
+	JsonLinesReporter	reporter(oss);
+	reporter.begin();
+	for(const auto &result : results) {
+		if(result.isTestFailed()) {
+			reporter.report(result);
+		}
+	}
+	reporter.end();
+	return	buf + oss.str();
+}
+
+} // anonymous namespace
+
+/*
+ * SoakMetrics
+ */
+SoakMetrics::SoakMetrics()
+:m_mutex()
+,m_entries()
+,m_start(std::chrono::steady_clock::now())
+{}
+
+void			SoakMetrics::record(const std::string &test, const std::vector<TestResult> &results, std::chrono::nanoseconds elapsed)
+{
+	std::lock_guard<std::mutex>	lock(m_mutex);
+	auto			&entry = m_entries[test];
+	++entry.runs;
+	size_t			cases = 0;
+	bool			failed = false;
+	for(const auto &result : results) {
+		const size_t	n = result.passCount + result.skipCount;
+		entry.passes += result.passCount;
+		entry.skips += result.skipCount;
+		cases += n;
+		failed = failed || result.isTestFailed();
+		if(!n) {
+			continue;
+		}
+		const double	latency = toSeconds(result.elapsed) / static_cast<double>(n);
+		if(entry.latencies.size() < latencyWindow) {
+			entry.latencies.push_back(latency);
+		} else {
+			entry.latencies[entry.latencyNext] = latency;
+		}
+		entry.latencyNext = (entry.latencyNext + 1) % latencyWindow;
+		entry.latencySum += latency;
+		++entry.latencyCount;
+	}
+	if(failed) {
+		++entry.failures;
+	}
+	const double	seconds = toSeconds(elapsed);
+	entry.lastRate = (0.0 < seconds) ? static_cast<double>(cases) / seconds : 0.0;
+}
+
+std::string		SoakMetrics::prometheusText(void) const
+{
+	static const double	quantiles[] = {0.5, 0.9, 0.99};
+	std::ostringstream	oss;
+	oss << std::setprecision(9);
+	std::lock_guard<std::mutex>	lock(m_mutex);
+	const auto		family = [&oss](const char *name, const char *type, const char *help) {
+			oss << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+		};
+	family("protest_soak_uptime_seconds", "gauge", "Seconds since the soak run started.");
+	oss << "protest_soak_uptime_seconds " << toSeconds(std::chrono::steady_clock::now() - m_start) << '\n';
+	// 同じ名前の行はまとめて書く必要があるので、指標ごとに全てのテストを回る。
+	const auto		perTest = [&](const char *name, const char *type, const char *help, auto value) {
+			family(name, type, help);
+			for(const auto &e : m_entries) {
+				oss << name << "{test=\"" << detail::prometheusLabel(e.first) << "\"} " << value(e.second) << '\n';
+			}
+		};
+	perTest("protest_soak_runs_total", "counter", "Completed runs of the test.",
+			[](const Entry &e) { return e.runs; });
+	perTest("protest_soak_passes_total", "counter", "Passed cases (sum of passCount).",
+			[](const Entry &e) { return e.passes; });
+	perTest("protest_soak_skips_total", "counter", "Skipped cases (sum of skipCount).",
+			[](const Entry &e) { return e.skips; });
+	perTest("protest_soak_failures_total", "counter", "Failed runs of the test.",
+			[](const Entry &e) { return e.failures; });
+	perTest("protest_soak_cases_per_second", "gauge", "Passed and skipped cases per second in the last run.",
+			[](const Entry &e) { return e.lastRate; });
+	perTest("protest_soak_skip_ratio", "gauge", "Skipped cases over all generated cases.",
+			[](const Entry &e) {
+				const size_t	total = e.passes + e.skips;
+				return	total ? static_cast<double>(e.skips) / static_cast<double>(total) : 0.0;
+			});
+	family("protest_soak_case_latency_seconds", "summary", "Time per case, averaged over each reported result.");
+	for(const auto &e : m_entries) {
+		const std::string	label = detail::prometheusLabel(e.first);
+		auto			sorted = e.second.latencies;
+		std::sort(sorted.begin(), sorted.end());
+		for(const double q : quantiles) {
+			oss << "protest_soak_case_latency_seconds{test=\"" << label << "\",quantile=\"" << q << "\"} ";
+			if(sorted.empty()) {
+				oss << "NaN\n";
+			} else {
+				oss << sorted[static_cast<size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5)] << '\n';
+			}
+		}
+		oss << "protest_soak_case_latency_seconds_sum{test=\"" << label << "\"} " << e.second.latencySum << '\n'
+			<< "protest_soak_case_latency_seconds_count{test=\"" << label << "\"} " << e.second.latencyCount << '\n';
+	}
+	return	oss.str();
+}
+
+bool			SoakMetrics::writeFile(const std::string &path) const
+{
+	const std::string	tmp = path + ".tmp";
+	{
+		std::ofstream	ofs(tmp, std::ios::out | std::ios::trunc);
+		if(!ofs || !(ofs << prometheusText()) || !ofs.flush()) {
+			return	false;
+		}
+	}
+	return	std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+void			requestSoakStop(void)
+{
+	soakStop = true;
+}
+
+namespace	detail {
+
+uint64_t		soakSeed(uint64_t base, size_t round, size_t index)
+{
+	// splitmix64 。隣り合う周回やテストのシードが似た値にならないよう混ぜる。
+	uint64_t		z = base + ((static_cast<uint64_t>(round) << 32) ^ index) * 0x9e3779b97f4a7c15ULL;
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return	z ^ (z >> 31);
+}
+
+std::string		prometheusLabel(const std::string &str)
+{
+	std::string		ret;
+	for(const char c : str) {
+		switch(c) {
+			case '\\':
+				ret += "\\\\";
+				break;
+			case '"':
+				ret += "\\\"";
+				break;
+			case '\n':
+				ret += "\\n";
+				break;
+			default:
+				ret += c;
+				break;
+		}
+	}
+	return	ret;
+}
+
+} // namespace detail
+
+int				runSoak(const TestRegistry &registry, const RunnerOptions &opts, std::ostream &ost)
+{
+	const auto		selected = selectTests(registry, opts);
+	const bool		textAvailable = isOstreamAvailable(ost);
+	if(selected.empty()) {
+		if(textAvailable) {
+			ost << "no test to soak" << std::endl;
+		}
+		return	0;
+	}
+	const uint64_t	baseSeed = opts.seed ? *opts.seed : detail::randomSeed();
+	if(textAvailable) {
+		ost << "soak: " << selected.size() << " tests, base seed " << baseSeed << std::endl;
+	}
+	soakStop = false;
+
+	SoakMetrics		metrics;
+	std::atomic<bool>	done(false);
+	std::mutex		mutex;
+	std::condition_variable	cv;
+	std::thread		publisher;
+	if(!opts.metricsFile.empty()) {
+		publisher = std::thread([&]() {
+				std::unique_lock<std::mutex>	lock(mutex);
+				while(!cv.wait_for(lock, opts.metricsInterval, [&done]() { return done.load(); })) {
+					lock.unlock();
+					metrics.writeFile(opts.metricsFile);
+					lock.lock();
+				}
+			});
+	}
+	MetricsSocket	socket;
+	std::thread		server;
+	if(!opts.metricsSocket.empty()) {
+		if(socket.listen(opts.metricsSocket)) {
+			server = std::thread([&]() {
+					socket.serve(metrics, done);
+				});
+		} else if(textAvailable) {
+			ost << "cannot listen on metrics socket: " << opts.metricsSocket << std::endl;
+		}
+	}
+
+	// 全てのワーカーで一つの通し番号を取り、周回数とテストの位置に分ける。
+	std::atomic<size_t>	next(0);
+	std::atomic<size_t>	completed(0);
+	std::atomic<size_t>	failures(0);
+	std::mutex		outMutex;
+	const auto		worker = [&]() {
+			while(!soakStop) {
+				const size_t	k = next++;
+				const size_t	round = k / selected.size();
+				const size_t	index = k % selected.size();
+				if(opts.soakRounds && (round >= opts.soakRounds)) {
+					break;
+				}
+				const auto		&test = *selected[index];
+				const uint64_t	seed = detail::soakSeed(baseSeed, round, index);
+				CollectingReporter	reporter;
+				TestContext		ctx(nullOstream(), &reporter, seed);
+				const auto		startTime = std::chrono::steady_clock::now();
+				detail::runTestCatching(test, ctx);
+				metrics.record(test.name, reporter.results, std::chrono::steady_clock::now() - startTime);
+				++completed;
+				if(!ctx.failed()) {
+					continue;
+				}
+				++failures;
+				if(!opts.soakCorpus.empty()) {
+					coverage::storeCorpusEntry(opts.soakCorpus, failureRecord(test.name, round, seed, reporter.results));
+				}
+				if(textAvailable) {
+					std::lock_guard<std::mutex>	lock(outMutex);
+					ost << "[" SGR(BOLD, FG_RED) "FAIL" SGR(RESET) "] " << test.name
+						<< " (round " << round << ", seed " << seed << ")\n";
+					for(const auto &result : reporter.results) {
+						if(result.isTestFailed()) {
+							printResult(ost, result);
+						}
+					}
+					ost.flush();
+				}
+			}
+		};
+	const size_t	jobs = opts.jobs ? opts.jobs : std::max<size_t>(1, std::thread::hardware_concurrency());
+	std::vector<std::thread>	workers;
+	for(size_t i = 1; i < jobs; ++i) {
+		workers.emplace_back(worker);
+	}
+	worker();
+	for(auto &t : workers) {
+		t.join();
+	}
+
+	{
+		std::lock_guard<std::mutex>	lock(mutex);
+		done = true;
+	}
+	cv.notify_all();
+	if(publisher.joinable()) {
+		publisher.join();
+	}
+	if(server.joinable()) {
+		server.join();
+	}
+	// 最後の状態を書いておく。
+	if(!opts.metricsFile.empty() && !metrics.writeFile(opts.metricsFile) && textAvailable) {
+		ost << "cannot write metrics file: " << opts.metricsFile << std::endl;
+	}
+	if(textAvailable) {
+		ost << "\nsoak: " << completed << " runs, " << failures << " failed" << std::endl;
+	}
+	return	failures ? 1 : 0;
+}
+
+} // namespace protest
+} // namespace nu11p0
@@ -0,0 +1,109 @@
+/*!
+ * \file   watchdog.cpp
+ * \brief  Worker thread which runs test cases with a time limit.
+ * \author Larry-o <nu11p0.6477@gmail.com>
+ * \date   2026/10/19
+ * C++ version: C++14
+ */
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <protest/watchdog.hpp>
+
+namespace	nu11p0 {
+namespace	protest {
+
+namespace	{
+
+std::atomic<size_t>	abandoned(0);
+
+} // anonymous namespace
+
+WatchdogJob::~WatchdogJob() = default;
+
+//! ワーカースレッドと共有する状態。放棄されたスレッドはこれを単独で保持し続ける。
+struct	Watchdog::State {
+	std::mutex		mutex;
+	std::condition_variable	cond;
+	std::shared_ptr<WatchdogJob>	job;
+	bool			done;
+	//! ワーカーを終了させる。放棄する場合も立てる。
+	bool			quit;
+	State()
+	:mutex()
+	,cond()
+	,job()
+	,done(false)
+	,quit(false)
+	{}
+};
+
+Watchdog::Watchdog()
+:m_state()
+,m_thread()
+{}
+
+Watchdog::~Watchdog()
+{
+	if(m_thread.joinable()) {
+		{
+			std::lock_guard<std::mutex>	lock(m_state->mutex);
+			m_state->quit = true;
+		}
+		m_state->cond.notify_all();
+		m_thread.join();
+	}
+}
+
+bool			Watchdog::run(const std::shared_ptr<WatchdogJob> &job, std::chrono::nanoseconds timeout)
+{
+	if(!m_thread.joinable()) {
+		m_state = std::make_shared<State>();
+		m_thread = std::thread(workerMain, m_state);
+	}
+	std::unique_lock<std::mutex>	lock(m_state->mutex);
+	m_state->job = job;
+	m_state->done = false;
+	m_state->cond.notify_all();
+	auto			&state = *m_state;
+	if(m_state->cond.wait_for(lock, timeout, [&state]() { return state.done; })) {
+		return	true;
+	}
+	// ジョブが終わるまでワーカーは状態を保持しているので、こちらの参照は捨ててよい。
+	m_state->quit = true;
+	lock.unlock();
+	m_thread.detach();
+	m_state.reset();
+	++abandoned;
+	return	false;
+}
+
+size_t			Watchdog::abandonedCount(void)
+{
+	return	abandoned.load();
+}
+
+void			Watchdog::workerMain(std::shared_ptr<State> state)
+{
+	std::unique_lock<std::mutex>	lock(state->mutex);
+	for(;;) {
+		state->cond.wait(lock, [&state]() { return state->job || state->quit; });
+		if(!state->job) {
+			return;
+		}
+		auto			job = std::move(state->job);
+		lock.unlock();
+		job->run();
+		// 放棄されたジョブの後始末(ケースの破棄等)もこのスレッドで行う。
+		job.reset();
+		lock.lock();
+		state->done = true;
+		state->cond.notify_all();
+		if(state->quit) {
+			return;
+		}
+	}
+}
+
+} // namespace protest
+} // namespace nu11p0